@@ -0,0 +1,164 @@
+#include "../sim/world.h"
+#include "../sim/tank.h"
+#include "../sim/shot.h"
+#include "../sim/shot_batch.h"
+#include "../sim/terrain.h"
+
+#include <algorithm> // max, min
+#include <chrono>    // timing
+#include <cstdio>    // output
+
+// constants
+#define BENCH_WORLDS 20
+#define SETTLE_TICKS 600
+#define MAX_TRACE_STEPS 20000
+
+// forward declarations
+double elapsed_ms(chrono::steady_clock::time_point started);
+world settled_world(int seed);
+void every_shot(tank shooter, vector<shot> &shots);
+world_point scalar_trace(const world &w, shot s, double wind, double clear_y, bool &exploded);
+double clear_height(const world &w);
+
+/**
+ * Traces every angle by every power a tank can fire, the whole of a cold
+ * firing table, one shot at a time and then as one shot batch, in a spread
+ * of worlds and winds. The shot at a time trace steps each shot as shot_tick
+ * would, skipping the contact test while the shot is above everything in the
+ * world, the way tracing was done before batches. Both must land every shot
+ * in the same place; this fails if they don't, or if the batch is no faster.
+ */
+int main()
+{
+    double scalar_ms = 0, batch_ms = 0;
+    long traced = 0;
+    int mismatched = 0;
+    vector<shot> shots;
+    vector<world_point> landed;
+    vector<bool> exploded;
+    shot_batch b = new_shot_batch();
+
+    for ( int v = 1; v <= BENCH_WORLDS; v++ )
+    {
+        world w = settled_world(v);
+        double wind = (v % 11 - 5) * 0.05;
+        every_shot(*(w.active_tank), shots);
+        landed.resize(shots.size());
+        exploded.resize(shots.size());
+        traced += shots.size();
+
+        auto started = chrono::steady_clock::now();
+        double clear_y = clear_height(w);
+        for ( int i = 0; i < shots.size(); i++ )
+        {
+            bool e;
+            landed[i] = scalar_trace(w, shots[i], wind, clear_y, e);
+            exploded[i] = e;
+        }
+        scalar_ms += elapsed_ms(started);
+
+        started = chrono::steady_clock::now();
+        clear_shot_batch(b);
+        for ( int i = 0; i < shots.size(); i++ )
+        {
+            add_to_shot_batch(b, shots[i]);
+        }
+        trace_shot_batch(w, b, wind);
+        batch_ms += elapsed_ms(started);
+
+        for ( int i = 0; i < shots.size(); i++ )
+        {
+            mismatched += landed[i].x != b.landed[i].x or landed[i].y != b.landed[i].y or
+                          exploded[i] != bool(b.exploded[i]);
+        }
+    }
+
+    printf("%ld shots: one at a time %7.2f ms, batch %7.2f ms, %.2fx faster, %d landed differently\n",
+           traced, scalar_ms, batch_ms, scalar_ms / batch_ms, mismatched);
+
+    return mismatched == 0 and batch_ms < scalar_ms ? 0 : 1;
+}
+
+/**
+ * milliseconds since a point in time
+ */
+double elapsed_ms(chrono::steady_clock::time_point started)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+}
+
+/**
+ * a world on one of the presets with its tanks dropped and settled
+ */
+world settled_world(int seed)
+{
+    world w = new_world(seed, DEFAULT_WORLD_WIDTH, terrain_preset(seed % 4));
+    w.fall_speed = INSTANT_FALL;
+    for ( int i = 1; i <= 2 + seed % 3; i++ )
+    {
+        w.tanks.push_back(new_tank(i));
+    }
+    start_match(w);
+    for ( int i = 0; i < SETTLE_TICKS; i++ )
+    {
+        tick(w);
+    }
+
+    return w;
+}
+
+/**
+ * every angle by every power the tank can aim at
+ */
+void every_shot(tank shooter, vector<shot> &shots)
+{
+    shots.clear();
+    for ( int a = TANK_MIN_ANGLE + shooter.base_angle + 2; a <= TANK_MAX_ANGLE - shooter.base_angle - 2; a++ )
+    {
+        for ( int p = TANK_MIN_POWER; p <= TANK_MAX_POWER; p++ )
+        {
+            shooter.turret_angle = a;
+            shooter.power = p;
+            set_turret_position(shooter);
+            shots.push_back(new_shot(shooter));
+        }
+    }
+}
+
+/**
+ * step one shot until it hits something or leaves the world
+ */
+world_point scalar_trace(const world &w, shot s, double wind, double clear_y, bool &exploded)
+{
+    world_point contact;
+
+    exploded = false;
+    for ( int i = 0; i < MAX_TRACE_STEPS; i++ )
+    {
+        if ( max(s.previous.y, s.coords.y) >= clear_y and shot_hits(w, s.previous, s.coords, contact) )
+        {
+            exploded = true;
+            return contact;
+        }
+        if ( shot_off_world(w, s.coords) ) break;
+        move_shot(s, wind);
+    }
+
+    return s.coords;
+}
+
+/**
+ * Everything above this height is open sky: higher than the highest ground,
+ * above every tank however it leans, and above the base of the world.
+ */
+double clear_height(const world &w)
+{
+    double clear_y = min(WORLD_HEIGHT - 2, highest_ground(w.game_terrain, 0, w.game_terrain.width - 1));
+
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        clear_y = min(clear_y, w.tanks[i].coords.y - 2 * TANK_RADIUS);
+    }
+
+    return clear_y;
+}
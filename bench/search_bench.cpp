@@ -0,0 +1,84 @@
+#include "../sim/world.h"
+#include "../sim/tank.h"
+#include "../sim/firing_table.h"
+#include "../sim/shot_search.h"
+
+#include <chrono> // timing
+#include <cstdio> // output
+
+// constants
+#define BENCH_WORLDS 40
+#define SETTLE_TICKS 600
+#define FRAME_MS 16.0
+
+// forward declarations
+double elapsed_ms(chrono::steady_clock::time_point started);
+world settled_world(int seed, int tanks);
+
+/**
+ * Times the search brain's shot search across a spread of worlds: cold, with
+ * an empty firing table as on a tank's first turn, and warm, with the table
+ * the cold search left behind. A cold search has to fit in a frame, so this
+ * fails if the slowest one doesn't.
+ */
+int main()
+{
+    double cold_ms = 0, warm_ms = 0, slowest_ms = 0;
+
+    for ( int v = 1; v <= BENCH_WORLDS; v++ )
+    {
+        world w = settled_world(v, 2 + v % 3);
+        tank &shooter = *(w.active_tank);
+        const tank &target = w.tanks[shooter.id % w.tanks.size()];
+        firing_table table = new_firing_table();
+        int angle, power;
+
+        auto started = chrono::steady_clock::now();
+        search_shot(w, shooter, target, table, angle, power);
+        double ms = elapsed_ms(started);
+        cold_ms += ms;
+        slowest_ms = max(slowest_ms, ms);
+
+        started = chrono::steady_clock::now();
+        search_shot(w, shooter, target, table, angle, power);
+        warm_ms += elapsed_ms(started);
+    }
+
+    printf("cold search %6.2f ms (slowest %6.2f ms), warm search %6.3f ms\n", cold_ms / BENCH_WORLDS,
+           slowest_ms, warm_ms / BENCH_WORLDS);
+
+    if ( slowest_ms >= FRAME_MS )
+    {
+        printf("a cold search took longer than a %.0f ms frame\n", FRAME_MS);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * milliseconds since a point in time
+ */
+double elapsed_ms(chrono::steady_clock::time_point started)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+}
+
+/**
+ * a world on one of the presets with its tanks dropped and settled
+ */
+world settled_world(int seed, int tanks)
+{
+    world w = new_world(seed, DEFAULT_WORLD_WIDTH, terrain_preset(seed % 4));
+    w.fall_speed = INSTANT_FALL;
+    for ( int i = 1; i <= tanks; i++ )
+    {
+        w.tanks.push_back(new_tank(i));
+    }
+    start_match(w);
+    for ( int i = 0; i < SETTLE_TICKS; i++ )
+    {
+        tick(w);
+    }
+
+    return w;
+}
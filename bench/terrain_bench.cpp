@@ -0,0 +1,108 @@
+#include "../sim/terrain.h"
+#include "../sim/terrain_noise.h"
+#include "../sim/random.h"
+
+#include <algorithm> // max
+#include <chrono>    // timing
+#include <cstdio>    // output
+#include <cstdlib>   // abs
+#include <thread>    // hardware_concurrency
+
+// constants
+#define BENCH_SEED 42
+#define BENCH_COLUMNS 8000000
+
+// forward declarations
+double elapsed_ms(chrono::steady_clock::time_point started);
+void bench_preset(const char *name, terrain_preset preset);
+int steepest(const vector<int> &surface);
+
+/**
+ * Times the noise terrain presets across a range of world widths, on one
+ * thread and on every core, and checks both give the same surface. The
+ * classic generator is timed alongside for comparison.
+ */
+int main()
+{
+    printf("%-10s %9s %12s %12s %9s %6s\n", "preset", "columns", "1 thread ms", "all ms", "ns/col", "slope");
+    bench_preset("classic", CLASSIC_TERRAIN);
+    bench_preset("hills", ROLLING_HILLS);
+    bench_preset("plateaus", PLATEAUS);
+    bench_preset("mountains", MOUNTAINS);
+
+    return 0;
+}
+
+/**
+ * milliseconds since a point in time
+ */
+double elapsed_ms(chrono::steady_clock::time_point started)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - started).count();
+}
+
+/**
+ * Generate surfaces from 800 columns up, repeating the narrow ones so each
+ * width gets about the same number of columns in total. Classic terrain has
+ * no threaded path, so it is whole terrains built one after another.
+ */
+void bench_preset(const char *name, terrain_preset preset)
+{
+    int threads = max(1u, thread::hardware_concurrency());
+
+    for ( int width = DEFAULT_WORLD_WIDTH; width <= BENCH_COLUMNS; width *= 10 )
+    {
+        int rounds = max(1, BENCH_COLUMNS / width);
+        vector<int> single, parallel;
+        int slope = 0;
+
+        auto started = chrono::steady_clock::now();
+        for ( int i = 0; i < rounds; i++ )
+        {
+            random_stream r = new_random_stream(BENCH_SEED + i, TERRAIN_STREAM);
+            if ( preset == CLASSIC_TERRAIN )
+            {
+                terrain t = new_terrain(r, width, preset);
+                slope = max(slope, steepest(t.tops));
+            }
+            else
+            {
+                generate_noise_surface(r.key, preset, width, 1, single);
+                slope = max(slope, steepest(single));
+            }
+        }
+        double single_ms = elapsed_ms(started) / rounds;
+
+        double parallel_ms = single_ms;
+        bool same = true;
+        if ( preset != CLASSIC_TERRAIN )
+        {
+            started = chrono::steady_clock::now();
+            for ( int i = 0; i < rounds; i++ )
+            {
+                random_stream r = new_random_stream(BENCH_SEED + i, TERRAIN_STREAM);
+                generate_noise_surface(r.key, preset, width, threads, parallel);
+            }
+            parallel_ms = elapsed_ms(started) / rounds;
+            same = single == parallel;
+        }
+
+        printf("%-10s %9d %12.3f %12.3f %9.2f %6d%s\n", name, width, single_ms, parallel_ms,
+               1e6 * parallel_ms / width, slope, same ? "" : "  threads disagree!");
+    }
+}
+
+/**
+ * the biggest height difference between neighbouring columns
+ */
+int steepest(const vector<int> &surface)
+{
+    int slope = 0;
+
+    for ( int x = 1; x < surface.size(); x++ )
+    {
+        slope = max(slope, abs(surface[x] - surface[x - 1]));
+    }
+
+    return slope;
+}
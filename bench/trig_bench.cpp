@@ -0,0 +1,212 @@
+#include "../sim/world.h"
+#include "../sim/tank.h"
+#include "../sim/shot.h"
+#include "../sim/geometry.h"
+
+#include <chrono> // timing
+#include <cmath>  // reference trig
+#include <cstdio> // output
+
+// constants
+#define BENCH_SEED 42
+#define BENCH_TANKS 4
+#define SETTLE_TICKS 600
+#define LOOKUP_ROUNDS 20000
+#define UPDATE_TICKS 2000000
+
+// forward declarations
+double elapsed_ns(chrono::steady_clock::time_point started);
+void bench_lookups();
+void bench_update();
+double time_update(world &w, vector<shot> &shots, bool use_cmath);
+double radians(int degrees);
+void cmath_set_turret_position(tank &t);
+void cmath_move_shot(shot &s, double wind);
+
+/**
+ * Times the trig the simulation leans on: whole degree lookups against
+ * working the same values out with <cmath>, and a full tank and shot update
+ * as tank_tick and shot_tick would do it each tick.
+ */
+int main()
+{
+    bench_lookups();
+    bench_update();
+
+    return 0;
+}
+
+/**
+ * nanoseconds since a point in time
+ */
+double elapsed_ns(chrono::steady_clock::time_point started)
+{
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - started).count();
+}
+
+/**
+ * sin, cos and tan of every angle the tables cover, both ways
+ */
+void bench_lookups()
+{
+    volatile double sink = 0;
+    int calls = LOOKUP_ROUNDS * 541 * 3;
+
+    auto started = chrono::steady_clock::now();
+    for ( int r = 0; r < LOOKUP_ROUNDS; r++ )
+    {
+        double sum = 0;
+        for ( int d = -180; d <= 360; d++ )
+        {
+            sum += sin_deg(d) + cos_deg(d) + tan_deg(d + r % 2);
+        }
+        sink = sink + sum;
+    }
+    double table_ns = elapsed_ns(started) / calls;
+
+    started = chrono::steady_clock::now();
+    for ( int r = 0; r < LOOKUP_ROUNDS; r++ )
+    {
+        double sum = 0;
+        for ( int d = -180; d <= 360; d++ )
+        {
+            double radians = d * M_PI / 180.0;
+            sum += sin(radians) + cos(radians) + tan((d + r % 2) * M_PI / 180.0);
+        }
+        sink = sink + sum;
+    }
+    double cmath_ns = elapsed_ns(started) / calls;
+
+    printf("trig lookup:  %6.2f ns per call (cmath %6.2f ns)\n", table_ns, cmath_ns);
+}
+
+/**
+ * Every tank settles on the ground, turns its turret and has a shot in
+ * flight, which is as much trig as a tick ever does. The same update is
+ * timed again with the turret and the shots worked out with <cmath>, as
+ * they were before the tables; falling and the hit test are the same for
+ * both.
+ */
+void bench_update()
+{
+    world w = new_world(BENCH_SEED, DEFAULT_WORLD_WIDTH, CLASSIC_TERRAIN);
+    for ( int i = 1; i <= BENCH_TANKS; i++ )
+    {
+        w.tanks.push_back(new_tank(i));
+    }
+    start_match(w);
+    for ( int i = 0; i < SETTLE_TICKS; i++ )
+    {
+        for ( int t = 0; t < w.tanks.size(); t++ )
+        {
+            fall(w.tanks[t], w.game_terrain, FALL_SPEED);
+        }
+    }
+
+    vector<shot> shots;
+    for ( int t = 0; t < w.tanks.size(); t++ )
+    {
+        shots.push_back(new_shot(w.tanks[t]));
+    }
+
+    double table_ns = time_update(w, shots, false);
+    double cmath_ns = time_update(w, shots, true);
+
+    printf("tank update:  %6.1f ns per tick for %d tanks and shots (cmath %6.1f ns)\n", table_ns, BENCH_TANKS,
+           cmath_ns);
+}
+
+/**
+ * nanoseconds per tick of the tank and shot update, with table or <cmath> trig
+ */
+double time_update(world &w, vector<shot> &shots, bool use_cmath)
+{
+    auto started = chrono::steady_clock::now();
+    for ( int i = 0; i < UPDATE_TICKS; i++ )
+    {
+        for ( int t = 0; t < w.tanks.size(); t++ )
+        {
+            tank &moving = w.tanks[t];
+            fall(moving, w.game_terrain, FALL_SPEED);
+            moving.turret_angle = TANK_MIN_ANGLE + i % (TANK_MAX_ANGLE - TANK_MIN_ANGLE);
+            if ( use_cmath )
+            {
+                cmath_set_turret_position(moving);
+            }
+            else
+            {
+                set_turret_position(moving);
+            }
+
+            world_point contact;
+            if ( shot_hits(w, shots[t].previous, shots[t].coords, contact) or
+                 shot_off_world(w, shots[t].coords) )
+            {
+                shots[t] = new_shot(moving);
+            }
+            if ( use_cmath )
+            {
+                cmath_move_shot(shots[t], w.wind_strength);
+            }
+            else
+            {
+                move_shot(shots[t], w.wind_strength);
+            }
+        }
+    }
+
+    return elapsed_ns(started) / UPDATE_TICKS;
+}
+
+/**
+ * an angle in whole degrees as radians
+ */
+double radians(int degrees)
+{
+    return degrees * M_PI / 180.0;
+}
+
+/**
+ * set_turret_position, with the trig worked out each time
+ */
+void cmath_set_turret_position(tank &t)
+{
+    world_point center = mid_base_point(t);
+
+    if ( t.turret_angle <= 90 )
+    {
+        t.turret_end.x = cos(radians(t.turret_angle)) * 1.5 * TANK_RADIUS + center.x;
+        t.turret_end.y = center.y - sin(radians(t.turret_angle)) * 1.5 * TANK_RADIUS;
+    }
+    else
+    {
+        t.turret_end.x = -cos(radians(180 - t.turret_angle)) * 1.5 * TANK_RADIUS + center.x;
+        t.turret_end.y = center.y - sin(radians(180 - t.turret_angle)) * 1.5 * TANK_RADIUS;
+    }
+}
+
+/**
+ * move_shot, with the trig worked out each time
+ */
+void cmath_move_shot(shot &s, double wind)
+{
+    s.previous = s.coords;
+
+    if ( s.initial_angle != 90 )
+    {
+        double c = cos(radians(s.initial_angle));
+        s.distance += c * SHOT_SPEED;
+        s.coords.x += c * SHOT_SPEED;
+
+        double d = s.distance - s.initial_x;
+        s.coords.y = s.initial_y - d * tan(radians(s.initial_angle)) +
+                     (GRAVITATIONAL_ACCELERATION * d * d) / (2 * pow(s.power * c, 2));
+    }
+    else
+    {
+        double previous_velocity = s.power;
+        s.power -= 2 * SHOT_SPEED / GRAVITATIONAL_ACCELERATION;
+        s.coords.y += (pow(s.power, 2) - pow(previous_velocity, 2)) / (2 * GRAVITATIONAL_ACCELERATION);
+    }
+    s.coords.x += wind;
+}
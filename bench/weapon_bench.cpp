@@ -0,0 +1,206 @@
+#include "../sim/world.h"
+#include "../sim/tank.h"
+#include "../sim/shot.h"
+#include "../sim/geometry.h"
+#include "../sim/weapon.h"
+
+#include <chrono>  // timing
+#include <cstdio>  // output
+#include <cstdlib> // malloc, free
+#include <new>     // bad_alloc
+
+// constants
+#define BENCH_VOLLEYS 200
+#define SETTLE_TICKS 5
+#define MAX_VOLLEY_TICKS 5000
+#define DIRECT_HIT_WORLDS 50
+
+// every heap allocation the program makes is counted here
+long allocations = 0;
+
+// forward declarations
+double elapsed_ns(chrono::steady_clock::time_point started);
+bool bench_weapon(weapon_kind weapon);
+bool volley_over(const world &w);
+void check_direct_hits();
+
+/**
+ * Fires every weapon a tank can pick across a spread of worlds and aims,
+ * timing each volley from the shot until its last projectile is spent and
+ * the ground and tanks it hit have come to rest, counting the heap
+ * allocations it makes and checking the projectile pool never has to grow.
+ * Then checks a cluster bomb that lands straight on a tank throws no
+ * bomblets. A volley must not allocate, so this fails if any weapon does.
+ */
+int main()
+{
+    bool allocated = false;
+    weapon_kind weapon = SHELL;
+    do
+    {
+        allocated = bench_weapon(weapon) or allocated;
+        weapon = next_weapon(weapon);
+    }
+    while ( weapon != SHELL );
+    check_direct_hits();
+
+    if ( allocated )
+    {
+        printf("a volley allocated\n");
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * the global allocator, counting as it goes
+ */
+void *operator new(size_t size)
+{
+    allocations++;
+    void *p = malloc(size ? size : 1);
+    if ( not p )
+    {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+/**
+ * nanoseconds since a point in time
+ */
+double elapsed_ns(chrono::steady_clock::time_point started)
+{
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - started).count();
+}
+
+/**
+ * One volley a world, on every terrain preset, ticked whole until it is
+ * over. The events are drained each tick, as a front end would drain them.
+ * Returns whether any volley allocated.
+ */
+bool bench_weapon(weapon_kind weapon)
+{
+    double volley_ns = 0;
+    long volley_allocations = 0;
+    int most_projectiles = 0;
+    bool pool_grew = false;
+
+    for ( int v = 1; v <= BENCH_VOLLEYS; v++ )
+    {
+        world w = new_world(v, DEFAULT_WORLD_WIDTH, terrain_preset(v % 4));
+        w.fall_speed = INSTANT_FALL;
+        w.tanks.push_back(new_tank(1));
+        w.tanks.push_back(new_tank(2));
+        start_match(w);
+        for ( int i = 0; i < SETTLE_TICKS; i++ )
+        {
+            tick(w);
+        }
+
+        tank &shooter = *(w.active_tank);
+        shooter.weapon = weapon;
+        shooter.turret_angle = TANK_MIN_ANGLE + v % (TANK_MAX_ANGLE - TANK_MIN_ANGLE);
+        shooter.power = TANK_MIN_POWER + v % (TANK_MAX_POWER - TANK_MIN_POWER);
+        size_t capacity = w.projectiles.capacity();
+
+        w.events.clear();
+        long allocations_before = allocations;
+        auto started = chrono::steady_clock::now();
+        shoot(w, shooter);
+        for ( int i = 0; i < MAX_VOLLEY_TICKS and not volley_over(w); i++ )
+        {
+            tick(w);
+            w.events.clear();
+            most_projectiles = max(most_projectiles, int(w.projectiles.size()));
+        }
+        volley_ns += elapsed_ns(started);
+        volley_allocations += allocations - allocations_before;
+        pool_grew = pool_grew or w.projectiles.capacity() != capacity;
+    }
+
+    printf("%-13s %8.1f us per volley, %5.2f allocations per volley, up to %2d projectiles, pool %s\n",
+           weapon_name(weapon), volley_ns / BENCH_VOLLEYS / 1000, double(volley_allocations) / BENCH_VOLLEYS,
+           most_projectiles, pool_grew ? "grew" : "never grew");
+
+    return volley_allocations != 0;
+}
+
+/**
+ * is the volley over? It is once every projectile is spent, the turn has
+ * passed, and the ground and tanks it hit have stopped moving
+ */
+bool volley_over(const world &w)
+{
+    if ( not w.projectiles.empty() or not w.game_terrain.settling.empty() or not w.awake_tanks.empty() )
+    {
+        return false;
+    }
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        if ( w.tanks[i].shooting ) return false;
+    }
+    return true;
+}
+
+/**
+ * Drop a cluster bomb onto the other tank, square to its hull, across the
+ * middle of it, in a spread of worlds. A bomb that bursts on the tank must
+ * leave nothing in the pool after it does.
+ */
+void check_direct_hits()
+{
+    int hits = 0;
+    int threw_bomblets = 0;
+
+    for ( int v = 1; v <= DIRECT_HIT_WORLDS; v++ )
+    {
+        for ( int across = -TANK_RADIUS / 2 + 1; across < TANK_RADIUS / 2; across++ )
+        {
+            world w = new_world(v, DEFAULT_WORLD_WIDTH, terrain_preset(v % 4));
+            w.fall_speed = INSTANT_FALL;
+            w.tanks.push_back(new_tank(1));
+            w.tanks.push_back(new_tank(2));
+            start_match(w);
+            for ( int i = 0; i < SETTLE_TICKS; i++ )
+            {
+                tick(w);
+            }
+
+            // from above the hull down into its middle, leaning with it
+            tank &shooter = *(w.active_tank);
+            const tank &target = w.tanks[shooter.id % 2];
+            world_point center = tank_center(target);
+            double c = cos_deg(target.base_angle);
+            double s = sin_deg(target.base_angle);
+            shot bomb = new_shot(shooter);
+            bomb.coords.x = center.x + across * c;
+            bomb.coords.y = center.y + across * s;
+            bomb.previous.x = bomb.coords.x + s * TANK_RADIUS;
+            bomb.previous.y = bomb.coords.y - c * TANK_RADIUS;
+            shooter.weapon = CLUSTER_BOMB;
+            shooter.active_shot = bomb;
+            fire_weapon(w, shooter);
+            w.events.clear();
+            projectiles_tick(w);
+
+            if ( not w.events.empty() and w.events[0].kind == SHOT_EXPLODED )
+            {
+                hits++;
+                threw_bomblets += not w.projectiles.empty();
+            }
+        }
+    }
+
+    printf("cluster bombs landing on a tank: %d, of which %d threw bomblets\n", hits, threw_bomblets);
+}
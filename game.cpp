@@ -1,28 +1,44 @@
 #include "game.h"
-#include "brain.h"
 #include "menu_screen.h"
 #include "pause_screen.h"
 #include "hud.h"
-#include "tank.h"
-#include "terrain.h"
-#include "shot.h"
+#include "particles.h"
+#include "render.h"
 #include "won_screen.h"
+#include "sim/world.h"
+#include "sim/tank.h"
+#include "sim/weapon.h"
 
-#include <cstdlib> // abs
+#include <algorithm> // max, min
+#include <chrono>    // frame timing
+#include <cmath>     // pow
+#include <random>    // random_device
+
+// constants
+#define TANK_EFFECT_VOLUME 0.6
+#define TICK_MS (1000.0 * TICK_SECONDS)
+#define MAX_FRAME_MS 250.0
+
+// the battlefield is a few screens wide, and the camera closes this much of
+// the gap to whatever it follows every tick's worth of time
+#define BATTLEFIELD_WIDTH (4 * WINDOW_WIDTH)
+#define CAMERA_EASE 0.1
 
 // forward declarations
+void camera_tick(game &g, double frame_ms);
 void draw_tanks(game &g);
-void ai_tick(game &g);
-void tank_tick(game &g);
-void shot_tick(game &g);
-void wind_tick(game &g);
-bool shot_impact(const game &g);
-bool shot_missed(const game &g);
-void next_player(game &g);
-void activate_random_tank(game &g);
-void initialize_tanks(game &g);
-bool tanks_too_close(const tank &t1, const tank &t2);
-bool touches_tank(const vector<tank> &tanks, const point_2d &coords);
+void draw_projectiles(game &g);
+void draw_explosions(game &g);
+void explosions_tick(game &g, double frame_ms);
+void effects_tick(game &g, double frame_ms);
+world_point interpolate(const world_point &from, const world_point &to, double alpha);
+void advance_world(game &g, double frame_ms);
+void take_snapshot(game &g);
+double now_ms();
+void handle_tank_input(game &g);
+void held_keys_tick(game &g);
+void handle_world_events(game &g);
+void handle_world_event(game &g, const world_event &e);
 
 /**
  * manages the game music loop
@@ -40,9 +56,9 @@ void play_game_music()
  */
 void handle_game_input(game &g)
 {
-    if ( not g.active_tank->is_ai )
+    if ( not g.game_world.active_tank->is_ai )
     {
-        handle_tank_input(*(g.active_tank), g.game_terrain);
+        handle_tank_input(g);
     }
 
     if ( key_typed(ESCAPE_KEY) )
@@ -52,156 +68,234 @@ void handle_game_input(game &g)
 }
 
 /**
- * draws the game when in playing state
+ * handle keys typed to shoot or change weapon; keys held down are stepped in
+ * the fixed tick by held_keys_tick
  */
-void draw_game(game &g)
+void handle_tank_input(game &g)
 {
-    draw_terrain(g.game_terrain);
-    draw_tanks(g);
+    world &w = g.game_world;
+    tank &t = *(w.active_tank);
+
+    if ( not t.shooting and not falling(t, w.game_terrain) )
+    {
+        if ( key_typed(SPACE_KEY) )
+        {
+            shoot(w, t);
+        }
+        if ( key_typed(TAB_KEY) )
+        {
+            t.weapon = next_weapon(t.weapon);
+        }
+    }
 }
 
 /**
- * draw all tanks
+ * keys held down change the power and turn the turret a step each tick, so
+ * they move as fast whatever the frame rate
  */
-void draw_tanks(game &g)
+void held_keys_tick(game &g)
 {
-    for ( int i = 0; i < g.tanks.size(); i++ )
+    world &w = g.game_world;
+    tank &t = *(w.active_tank);
+
+    if ( t.is_ai or t.shooting or falling(t, w.game_terrain) ) return;
+
+    if ( key_down(UP_KEY) and t.power < TANK_MAX_POWER )
     {
-        draw_tank(g.tanks[i]);
+        power_up(w, t);
     }
+    if ( key_down(DOWN_KEY) and t.power > TANK_MIN_POWER )
+    {
+        power_down(w, t);
+    }
+    if ( key_down(LEFT_KEY) and t.turret_angle + t.base_angle < TANK_MAX_ANGLE )
+    {
+        angle_up(w, t);
+    }
+    if ( key_down(RIGHT_KEY) and t.turret_angle + t.base_angle > TANK_MIN_ANGLE )
+    {
+        angle_down(w, t);
+    }
+}
+
+/**
+ * draws the game when in playing state
+ */
+void draw_game(game &g)
+{
+    int view_x = int(g.view.x);
+
+    move_camera_to(view_x, 0);
+    draw_terrain(g.terrain_image, g.game_world.game_terrain, view_x);
+    draw_tanks(g);
+    draw_projectiles(g);
+    draw_explosions(g);
+    draw_particles(g.particles, view_x);
+    // the hud and screens over the top are drawn to the window, not the world
+    move_camera_to(0, 0);
 }
 
 /**
- * a game tick passes a unit of time
+ * the camera eases towards the shot in flight, or the tank whose turn it is,
+ * keeping it in the middle of the window without going past either edge of
+ * the world. The easing compounds over the frame's length, so it closes in
+ * as fast at any frame rate.
  */
-void tick(game &g)
+void camera_tick(game &g, double frame_ms)
 {
-    ai_tick(g);
-    tank_tick(g);
-    shot_tick(g);
-    wind_tick(g);
+    world &w = g.game_world;
+    double focus_x = w.active_tank->shooting ? w.active_tank->active_shot.coords.x
+                                             : mid_base_point(*(w.active_tank)).x;
+    double target_x = focus_x - WINDOW_WIDTH / 2;
+    double ease = 1 - pow(1 - CAMERA_EASE, frame_ms / TICK_MS);
+
+    target_x = max(0.0, min(target_x, double(w.game_terrain.width - WINDOW_WIDTH)));
+    g.view.x += (target_x - g.view.x) * ease;
 }
 
 /**
- * ai does ai things for one tick
+ * draw all tanks, blended between where they were and are so falling looks
+ * smooth whatever the frame rate
  */
-void ai_tick(game &g)
+void draw_tanks(game &g)
 {
-    if ( g.active_tank->is_ai and not g.active_tank->shooting )
+    for ( int i = 0; i < g.game_world.tanks.size(); i++ )
     {
-        // think is synchronous so lets just get tick happening before and after
-        if ( g.active_tank->ai.state == READY )
-        {
-            act(g);
-        }
-        if ( g.active_tank->ai.state == THINKING )
+        const tank &t = g.game_world.tanks[i];
+        world_point coords = t.coords;
+        if ( i < g.previous.tank_coords.size() )
         {
-            think(g);
-        }
-        if ( g.active_tank->ai.state == WAITING )
-        {
-            g.active_tank->ai.state = THINKING;
+            coords = interpolate(g.previous.tank_coords[i], t.coords, g.interpolation);
         }
+        draw_tank(t, coords);
     }
 }
 
 /**
- * tanks fall for one tick
+ * draw every projectile in the pool, blended from where each was on the last
+ * tick, which it keeps itself, so ones split off since then blend too
  */
-void tank_tick(game &g)
+void draw_projectiles(game &g)
 {
-    for ( int i = 0; i < g.tanks.size(); i++ )
+    const vector<projectile> &pool = g.game_world.projectiles;
+
+    for ( int i = 0; i < pool.size(); i++ )
     {
-        fall(g.tanks[i], g.game_terrain);
+        shot shown = pool[i].flight;
+        shown.coords = interpolate(shown.previous, shown.coords, g.interpolation);
+        draw_shot(shown);
     }
 }
 
 /**
- * any active shot continues on its trajectory for one tick
+ * draw every explosion that is still playing
  */
-void shot_tick(game &g)
+void draw_explosions(game &g)
 {
-    if ( g.active_tank->shooting )
+    for ( int i = 0; i < g.explosions.size(); i++ )
     {
-        if ( shot_impact(g) )
-        {
-            g.active_tank->shooting = false;
-            explode(g.active_tank->active_shot, g.tanks, g.game_terrain);
-            next_player(g);
-        }
-        else if ( shot_missed(g) )
-        {
-            g.active_tank->shooting = false;
-            next_player(g);
-        }
-        else
-        {
-            move_shot(g.active_tank->active_shot, g.wind_strength);
-            draw_shot(g.active_tank->active_shot);
-        }
+        draw_explosion(g.explosions[i]);
     }
 }
 
 /**
- * the wind shifts randomly over time
+ * explosions age with real time and are dropped once they have played out
  */
-void wind_tick(game &g)
+void explosions_tick(game &g, double frame_ms)
 {
-    double chance = rnd();
-
-    // the wind shouldn't adjust excessively quickly
-    if ( chance < 0.03 and g.wind_strength > -1.0 )
+    for ( int i = 0; i < g.explosions.size(); i++ )
     {
-        g.wind_strength -= 0.01;
+        g.explosions[i].age_ms += frame_ms;
     }
-    else if ( chance < 0.06 and g.wind_strength < 1.0 )
+
+    int i = 0;
+    while ( i < g.explosions.size() )
     {
-        g.wind_strength += 0.01;
+        if ( explosion_finished(g.explosions[i]) )
+        {
+            g.explosions.erase(g.explosions.begin() + i);
+        }
+        else
+        {
+            i++;
+        }
     }
 }
 
 /**
- * the shot has has the ground or the base of the window
+ * explosions and particles play out in real time, whatever the world is doing
  */
-bool shot_impact(const game &g)
+void effects_tick(game &g, double frame_ms)
 {
-    return touches_ground(g.game_terrain, g.active_tank->active_shot.coords) or
-           touches_tank(g.tanks, g.active_tank->active_shot.coords) or
-           g.active_tank->active_shot.coords.y >= WINDOW_HEIGHT - 2;
+    explosions_tick(g, frame_ms);
+    particles_tick(g.particles, g.game_world.game_terrain, g.game_world.wind_strength, frame_ms);
 }
 
 /**
- * the shot is off the horizontal edge of the window
+ * a point part way from one point to another
  */
-bool shot_missed(const game &g)
+world_point interpolate(const world_point &from, const world_point &to, double alpha)
 {
-    return g.active_tank->active_shot.coords.x >= WINDOW_WIDTH or
-           g.active_tank->active_shot.coords.x <= 0;
+    world_point p;
+
+    p.x = from.x + (to.x - from.x) * alpha;
+    p.y = from.y + (to.y - from.y) * alpha;
+
+    return p;
 }
 
 /**
- * select the next player, unless the game has been won
+ * play and show whatever happened in the world since the last frame
  */
-void next_player(game &g)
+void handle_world_events(game &g)
 {
-    if ( game_won(g) )
+    for ( int i = 0; i < g.game_world.events.size(); i++ )
     {
-        win_game(g);
+        handle_world_event(g, g.game_world.events[i]);
     }
-    else
+    g.game_world.events.clear();
+}
+
+/**
+ * play and show a single world event
+ */
+void handle_world_event(game &g, const world_event &e)
+{
+    switch ( e.kind )
     {
-        if ( g.active_tank->id == g.tanks.size() )
-        {
-            g.active_tank = &(g.tanks[0]);
-        }
-        else
-        {
-            g.active_tank = &(g.tanks[g.active_tank->id]);
-        }
-        if ( not g.active_tank->alive )
-        {
-            next_player(g);
-        }
+        case SHOT_FIRED:
+            play_sound_effect("shoot");
+            break;
+        case POWER_CHANGED:
+            if ( not sound_effect_playing("power") )
+            {
+                play_sound_effect("power", 1, TANK_EFFECT_VOLUME);
+            }
+            break;
+        case ANGLE_CHANGED:
+            if ( not sound_effect_playing("angle") )
+            {
+                play_sound_effect("angle", 1, TANK_EFFECT_VOLUME / 3);
+            }
+            break;
+        case SHOT_EXPLODED:
+            g.explosions.push_back(new_explosion_animation(e.coords, e.radius));
+            spawn_explosion_particles(g.particles, e.coords, e.radius);
+            play_sound_effect("explode");
+            break;
+        case TERRAIN_CHANGED:
+            mark_terrain_dirty(g.terrain_image, e.first_column, e.last_column);
+            break;
+        case TANK_DESTROYED:
+            spawn_wreck_particles(g.particles, g.game_world.tanks[e.tank_id - 1]);
+            play_sound_effect("destroy");
+            break;
+        case MATCH_WON:
+            win_game(g);
+            break;
+        case MATCH_DRAWN:
+            // the game plays without a round limit, so is never drawn
+            break;
     }
 }
 
@@ -210,12 +304,17 @@ game new_game()
     game g;
 
     g.state = IN_MENU;
-    g.game_terrain = new_terrain();
-    g.tanks.push_back(new_tank(1));
-    g.tanks.push_back(new_tank(2));
+    g.game_world = new_world(random_device{}(), BATTLEFIELD_WIDTH, CLASSIC_TERRAIN);
+    g.game_world.tanks.push_back(new_menu_tank(1));
+    g.game_world.tanks.push_back(new_menu_tank(2));
+    g.last_frame_ms = now_ms();
+    g.tick_accumulator_ms = 0;
+    g.interpolation = 1;
+    g.terrain_image = new_terrain_tiles(g.game_world.game_terrain);
+    g.particles = new_particle_system(g.game_world.seed);
+    g.view.x = 0;
     g.menu_ui = new_menu_screen(g);
     g.won_ui = new_won_screen(g);
-    g.wind_strength = 0.0;
 
     return g;
 }
@@ -223,8 +322,49 @@ game new_game()
 void initialize_game(game &g)
 {
     stop_music();
-    activate_random_tank(g);
-    initialize_tanks(g);
+    start_match(g.game_world);
+    for ( int i = 0; i < g.game_world.tanks.size(); i++ )
+    {
+        g.game_world.tanks[i].ai.think_async = true;
+    }
+    take_snapshot(g);
+}
+
+/**
+ * Run as many fixed length world ticks as the time since the last frame
+ * covers, and carry the remainder over. Whatever is left over says how far
+ * we are between the last tick and the next, which drawing blends by. Very
+ * long frames are clamped so the simulation never tries to catch up on more
+ * than a moment.
+ */
+void advance_world(game &g, double frame_ms)
+{
+    g.tick_accumulator_ms += min(frame_ms, MAX_FRAME_MS);
+
+    while ( g.tick_accumulator_ms >= TICK_MS and g.state == PLAYING )
+    {
+        held_keys_tick(g);
+        take_snapshot(g);
+        tick(g.game_world);
+        handle_world_events(g);
+        g.tick_accumulator_ms -= TICK_MS;
+    }
+
+    g.interpolation = g.tick_accumulator_ms / TICK_MS;
+}
+
+/**
+ * remember where everything that moves is before the world ticks
+ */
+void take_snapshot(game &g)
+{
+    world &w = g.game_world;
+
+    g.previous.tank_coords.resize(w.tanks.size());
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        g.previous.tank_coords[i] = w.tanks[i].coords;
+    }
 }
 
 /**
@@ -240,13 +380,15 @@ void menu_loop(game &g)
 /**
  * perform playing loop actions for the main game
  */
-void playing_loop(game &g)
+void playing_loop(game &g, double frame_ms)
 {
     play_game_music();
     handle_game_input(g);
+    advance_world(g, frame_ms);
+    effects_tick(g, frame_ms);
+    camera_tick(g, frame_ms);
     draw_game(g);
     draw_hud(g);
-    tick(g);
 }
 
 /**
@@ -262,8 +404,9 @@ void paused_loop(game &g)
 /**
  * perform won loop actions for when the game has just been won
  */
-void won_loop(game &g)
+void won_loop(game &g, double frame_ms)
 {
+    effects_tick(g, frame_ms);
     draw_game(g);
     draw_won_screen(g);
     handle_won_screen_input(g);
@@ -273,6 +416,9 @@ void game_loop(game &g)
 {
     while ( not quit_requested() )
     {
+        double frame_ms = now_ms() - g.last_frame_ms;
+        g.last_frame_ms += frame_ms;
+
         process_events();
 
         clear_screen(BACKGROUND_COLOR);
@@ -283,13 +429,13 @@ void game_loop(game &g)
                 menu_loop(g);
                 break;
             case PLAYING:
-                playing_loop(g);
+                playing_loop(g, frame_ms);
                 break;
             case PAUSED:
                 paused_loop(g);
                 break;
             case WON:
-                won_loop(g);
+                won_loop(g, frame_ms);
                 break;
         }
 
@@ -298,55 +444,10 @@ void game_loop(game &g)
 }
 
 /**
- * picks a random tank to start the game
- */
-void activate_random_tank(game &g)
-{
-    g.active_tank = &(g.tanks[rnd(g.tanks.size())]);
-}
-
-/**
- * repeatedly reinitialize tanks until they're not too close to each other
- */
-void initialize_tanks(game &g)
-{
-    bool acceptable;
-    int i = 0;
-    while ( i < g.tanks.size() )
-    {
-        initialize_tank(g.tanks[i]);
-        acceptable = true;
-        for ( int j = 0; j < i; j++ )
-        {
-            if ( tanks_too_close(g.tanks[j], g.tanks[i]) )
-            {
-                acceptable = false;
-            }
-        }
-        if ( acceptable ) i++;
-    }
-}
-
-/**
- * are these tanks too close to spawn at this range?
- */
-bool tanks_too_close(const tank &t1, const tank &t2)
-{
-    return abs(int(t1.coords.x - t2.coords.x)) < MIN_PLAYER_GAP;
-}
-
-/**
- * does this point touch any tank
+ * milliseconds on a clock that only ever goes forwards
  */
-bool touches_tank(const vector<tank> &tanks, const point_2d &coords)
+double now_ms()
 {
-    bool touches = false;
-    for ( tank t: tanks )
-    {
-        if ( bitmap_point_collision(t.bmp, t.coords, coords) )
-        {
-            touches = true;
-        }
-    }
-    return touches;
+    chrono::duration<double, milli> since_start = chrono::steady_clock::now().time_since_epoch();
+    return since_start.count();
 }
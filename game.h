@@ -3,8 +3,9 @@
 
 #include "shared.h"
 
-#define MAX_PLAYERS 4
-#define MIN_PLAYER_GAP 60
+// the menu has room to set up this many players; the simulation takes up to
+// MAX_PLAYERS, which headless matches can use
+#define MENU_PLAYERS 4
 #define PLAYER_NAME_LENGTH 8
 
 /**
@@ -1,4 +1,6 @@
 #include "hud.h"
+#include "render.h"
+#include "sim/weapon.h"
 
 #include <cstdlib> // abs
 
@@ -7,6 +9,7 @@
 #define PLAYER_HUD_NAME_Y 10
 #define PLAYER_HUD_ANGLE_Y PLAYER_HUD_NAME_Y + FONT_SIZE
 #define PLAYER_HUD_POWER_Y PLAYER_HUD_ANGLE_Y + FONT_SIZE
+#define PLAYER_HUD_WEAPON_Y PLAYER_HUD_POWER_Y + FONT_SIZE
 #define WIND_X WINDOW_WIDTH - 110
 #define WIND_Y 10
 #define HEALTH_X WINDOW_WIDTH - 110
@@ -31,8 +34,8 @@ void draw_hud(const game &g)
  */
 void draw_player_hud(const game &g)
 {
-    string angle_text, power_text;
-    int angle = g.active_tank->turret_angle;
+    string angle_text, power_text, weapon_text;
+    int angle = g.game_world.active_tank->turret_angle;
     if ( angle > 90 )
     {
         angle_text = "ANGLE: < " + to_string(abs(angle - 90));
@@ -45,11 +48,13 @@ void draw_player_hud(const game &g)
     {
         angle_text = "ANGLE: 0";
     }
-    power_text = "POWER: " + to_string(g.active_tank->power);
+    power_text = "POWER: " + to_string(g.game_world.active_tank->power);
+    weapon_text = "WEAPON: " + string(weapon_name(g.game_world.active_tank->weapon));
 
-    draw_text(g.active_tank->name, g.active_tank->clr, TEXT_FONT, FONT_SIZE, PLAYER_HUD_X, PLAYER_HUD_NAME_Y);
+    draw_text(g.game_world.active_tank->name, tank_color(*(g.game_world.active_tank)), TEXT_FONT, FONT_SIZE, PLAYER_HUD_X, PLAYER_HUD_NAME_Y);
     draw_text(angle_text, COLOR_BLACK, TEXT_FONT, FONT_SIZE, PLAYER_HUD_X, PLAYER_HUD_ANGLE_Y);
     draw_text(power_text, COLOR_BLACK, TEXT_FONT, FONT_SIZE, PLAYER_HUD_X, PLAYER_HUD_POWER_Y);
+    draw_text(weapon_text, COLOR_BLACK, TEXT_FONT, FONT_SIZE, PLAYER_HUD_X, PLAYER_HUD_WEAPON_Y);
 }
 
 /**
@@ -68,13 +73,13 @@ void draw_wind(const game &g)
 {
     string wind_text;
 
-    if ( g.wind_strength < 0 )
+    if ( g.game_world.wind_strength < 0 )
     {
-        wind_text = "WIND: < " + to_string(abs(int(g.wind_strength * 100)));
+        wind_text = "WIND: < " + to_string(abs(int(g.game_world.wind_strength * 100)));
     }
-    else if ( g.wind_strength > 0 )
+    else if ( g.game_world.wind_strength > 0 )
     {
-        wind_text = "WIND:   " + to_string(abs(int(g.wind_strength * 100))) + " >";
+        wind_text = "WIND:   " + to_string(abs(int(g.game_world.wind_strength * 100))) + " >";
     }
     else
     {
@@ -88,11 +93,11 @@ void draw_wind(const game &g)
  */
 void draw_health_bars(const game &g)
 {
-    for ( int i = 0; i < g.tanks.size(); i++ )
+    for ( int i = 0; i < g.game_world.tanks.size(); i++ )
     {
         fill_rectangle(COLOR_BLACK, HEALTH_X - 1, HEALTH_Y + (HEALTH_HEIGHT + 5) * i - 1,
                        HEALTH_WIDTH + 2, HEALTH_HEIGHT + 2);
-        fill_rectangle(g.tanks[i].clr, HEALTH_X, HEALTH_Y + (HEALTH_HEIGHT + 5) * i,
-                       g.tanks[i].health, HEALTH_HEIGHT);
+        fill_rectangle(tank_color(g.game_world.tanks[i]), HEALTH_X, HEALTH_Y + (HEALTH_HEIGHT + 5) * i,
+                       g.game_world.tanks[i].health, HEALTH_HEIGHT);
     }
 }
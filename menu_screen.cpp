@@ -1,6 +1,8 @@
 #include "menu_screen.h"
 #include "game.h"
-#include "tank.h"
+#include "render.h"
+#include "sim/random.h"
+#include "sim/tank.h"
 
 // constants
 #define TITLE_COPY "DEFINITELY NOT SCORCHED EARTH"
@@ -34,20 +36,32 @@ void handle_player_toggles(game &g);
 void handle_name_boxes(game &g);
 void backspace(string *name);
 void type(string *name, string key);
-void handle_player_toggle(player_toggle &toggle, tank &t);
+void handle_player_toggle(player_toggle &toggle, tank &t, random_stream &names);
 void handle_name_box(menu_screen &m, ui_element &name_box, tank &t);
 void handle_play(game &g);
 
+tank new_menu_tank(int id)
+{
+    tank t = new_tank(id);
+
+    // the initial starting position is on the menu
+    t.coords.x = OUTER_RECT_X + OUTER_RECT_WIDTH * id / 5;
+    t.coords.y = TANKS_Y;
+
+    return t;
+}
+
 menu_screen new_menu_screen(const game &g)
 {
     menu_screen m;
     m.less_tanks = new_less_tanks_button();
     m.more_tanks = new_more_tanks_button();
     m.play = new_play_button();
-    m.player_toggles = new_player_toggles(g.tanks);
-    m.name_boxes = new_name_boxes(g.tanks);
+    m.player_toggles = new_player_toggles(g.game_world.tanks);
+    m.name_boxes = new_name_boxes(g.game_world.tanks);
     m.editing_name = false;
     m.editing_tank = NULL;
+    m.names = new_random_stream(g.game_world.seed, NAME_STREAM);
     return m;
 }
 
@@ -154,12 +168,12 @@ player_toggle new_player_toggle(const tank &t)
 
     ui_element human_toggle;
     human_toggle.coords.x = t.coords.x + 40;
-    human_toggle.coords.y = t.coords.y - bitmap_height(t.bmp) - 20;
+    human_toggle.coords.y = t.coords.y - TANK_RADIUS - 20;
     human_toggle.bmp = bitmap_named("human");
 
     ui_element robot_toggle;
     robot_toggle.coords.x = t.coords.x + 40;
-    robot_toggle.coords.y = t.coords.y - bitmap_height(t.bmp) - 20;
+    robot_toggle.coords.y = t.coords.y - TANK_RADIUS - 20;
     robot_toggle.bmp = bitmap_named("robot");
 
     toggle.human = human_toggle;
@@ -175,18 +189,18 @@ ui_element new_name_box(const tank &t)
 {
     ui_element name_box;
 
-    name_box.coords.x = t.coords.x + bitmap_width(t.bmp) / 2 - NAME_BOX_WIDTH / 2;
-    name_box.coords.y = t.coords.y + bitmap_height(t.bmp) + 10;
-    name_box.clr = t.clr;
+    name_box.coords.x = t.coords.x + TANK_RADIUS - NAME_BOX_WIDTH / 2;
+    name_box.coords.y = t.coords.y + TANK_RADIUS + 10;
+    name_box.clr = tank_color(t);
     name_box.bmp = create_bitmap("name_box" + to_string(t.id), NAME_BOX_WIDTH, NAME_BOX_HEIGHT);        
 
     // this increases the hitbox for clicks
     fill_rectangle_on_bitmap(name_box.bmp, COLOR_BLACK, 0, 0, NAME_BOX_WIDTH, NAME_BOX_HEIGHT);
 
-    fill_rectangle_on_bitmap(name_box.bmp, t.clr, 0, 0, NAME_BOX_WIDTH, 2);
-    fill_rectangle_on_bitmap(name_box.bmp, t.clr, 0, 0, 2, NAME_BOX_HEIGHT);
-    fill_rectangle_on_bitmap(name_box.bmp, t.clr, NAME_BOX_WIDTH - 2, 0, NAME_BOX_WIDTH, NAME_BOX_HEIGHT);
-    fill_rectangle_on_bitmap(name_box.bmp, t.clr, 0, NAME_BOX_HEIGHT - 2, NAME_BOX_WIDTH, NAME_BOX_WIDTH);
+    fill_rectangle_on_bitmap(name_box.bmp, name_box.clr, 0, 0, NAME_BOX_WIDTH, 2);
+    fill_rectangle_on_bitmap(name_box.bmp, name_box.clr, 0, 0, 2, NAME_BOX_HEIGHT);
+    fill_rectangle_on_bitmap(name_box.bmp, name_box.clr, NAME_BOX_WIDTH - 2, 0, NAME_BOX_WIDTH, NAME_BOX_HEIGHT);
+    fill_rectangle_on_bitmap(name_box.bmp, name_box.clr, 0, NAME_BOX_HEIGHT - 2, NAME_BOX_WIDTH, NAME_BOX_WIDTH);
     setup_collision_mask(name_box.bmp);
 
     return name_box;
@@ -236,14 +250,14 @@ void draw_fixed_copy()
  */
 void draw_tank_num_selection(const game &g)
 {
-    int num_tanks = g.tanks.size();
+    int num_tanks = g.game_world.tanks.size();
 
-    draw_text(to_string(g.tanks.size()), COLOR_LIGHT_GREEN, TEXT_FONT, BIG_FONT_SIZE, NUM_TANKS_X, TANK_QTY_Y);
+    draw_text(to_string(g.game_world.tanks.size()), COLOR_LIGHT_GREEN, TEXT_FONT, BIG_FONT_SIZE, NUM_TANKS_X, TANK_QTY_Y);
     if ( num_tanks > 2 )
     {
         draw_ui_element(g.menu_ui.less_tanks);
     }
-    if ( num_tanks < MAX_PLAYERS )
+    if ( num_tanks < MENU_PLAYERS )
     {
         draw_ui_element(g.menu_ui.more_tanks);
     }
@@ -255,7 +269,7 @@ void draw_tank_num_selection(const game &g)
 void draw_edit_name(const game &g)
 {
     draw_text(EDIT_TANK_NAME_COPY, COLOR_LIGHT_GREEN, TEXT_FONT, FONT_SIZE, NUM_TANKS_X, TANK_QTY_Y);
-    draw_tank(*(g.menu_ui.editing_tank));
+    draw_tank(*(g.menu_ui.editing_tank), g.menu_ui.editing_tank->coords);
     draw_name_box(*(g.menu_ui.editing_box), g.menu_ui.editing_tank->name);
 }
 
@@ -264,11 +278,11 @@ void draw_edit_name(const game &g)
  */
 void draw_tanks_on_menu_screen(game &g)
 {
-    for ( int i = 0; i < g.tanks.size(); i++ )
+    for ( int i = 0; i < g.game_world.tanks.size(); i++ )
     {
-        draw_player_toggle(g.menu_ui.player_toggles[i], g.tanks[i].is_ai);
-        draw_tank(g.tanks[i]);
-        draw_name_box(g.menu_ui.name_boxes[i], g.tanks[i].name);
+        draw_player_toggle(g.menu_ui.player_toggles[i], g.game_world.tanks[i].is_ai);
+        draw_tank(g.game_world.tanks[i], g.game_world.tanks[i].coords);
+        draw_name_box(g.menu_ui.name_boxes[i], g.game_world.tanks[i].name);
     }
 }
 
@@ -317,12 +331,12 @@ void handle_menu_screen_input(game &g)
  */
 void handle_less_tanks(game &g)
 {
-    if ( clicked_on(g.menu_ui.less_tanks) and g.tanks.size() > 2 )
+    if ( clicked_on(g.menu_ui.less_tanks) and g.game_world.tanks.size() > 2 )
     {
         play_sound_effect("click");
         g.menu_ui.name_boxes.pop_back();
         g.menu_ui.player_toggles.pop_back();
-        g.tanks.pop_back();
+        g.game_world.tanks.pop_back();
     }
 }
 
@@ -331,13 +345,13 @@ void handle_less_tanks(game &g)
  */
 void handle_more_tanks(game &g)
 {
-    if ( clicked_on(g.menu_ui.more_tanks) and g.tanks.size() < MAX_PLAYERS )
+    if ( clicked_on(g.menu_ui.more_tanks) and g.game_world.tanks.size() < MENU_PLAYERS )
     {
         play_sound_effect("click");
-        tank t = new_tank(g.tanks.size() + 1);
+        tank t = new_menu_tank(g.game_world.tanks.size() + 1);
         g.menu_ui.name_boxes.push_back(new_name_box(t));
         g.menu_ui.player_toggles.push_back(new_player_toggle(t));
-        g.tanks.push_back(t);
+        g.game_world.tanks.push_back(t);
     }
 }
 
@@ -348,7 +362,7 @@ void handle_player_toggles(game &g)
 {
     for ( int i = 0; i < g.menu_ui.player_toggles.size(); i++ )
     {
-        handle_player_toggle(g.menu_ui.player_toggles[i], g.tanks[i]);
+        handle_player_toggle(g.menu_ui.player_toggles[i], g.game_world.tanks[i], g.menu_ui.names);
     }
 }
 
@@ -359,7 +373,7 @@ void handle_name_boxes(game &g)
 {
     for ( int i = 0; i < g.menu_ui.name_boxes.size(); i++ )
     {
-        handle_name_box(g.menu_ui, g.menu_ui.name_boxes[i], g.tanks[i]);
+        handle_name_box(g.menu_ui, g.menu_ui.name_boxes[i], g.game_world.tanks[i]);
     }
 }
 
@@ -435,7 +449,7 @@ void type(string *name, string key)
 /**
  * handles an individual player toggle being clicked on
  */
-void handle_player_toggle(player_toggle &toggle, tank &t)
+void handle_player_toggle(player_toggle &toggle, tank &t, random_stream &names)
 {
     if ( clicked_on(toggle.human) )
     {
@@ -443,7 +457,7 @@ void handle_player_toggle(player_toggle &toggle, tank &t)
         t.is_ai = !t.is_ai;
         if ( t.is_ai )
         {
-            generate_name(t);
+            generate_name(t, names);
         }
     }
 }
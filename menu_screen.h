@@ -34,6 +34,14 @@
 #define NAME_BOX_WIDTH 113
 #define NAME_BOX_HEIGHT BIG_FONT_SIZE - 8
 
+/**
+ * Create and return a new tank with a known integer id, positioned on the menu.
+ *
+ * @param    the id
+ * @returns  the new tank
+ */
+tank new_menu_tank(int id);
+
 /**
  * Create and return a new menu ui object containing menu related ui elements.
  *
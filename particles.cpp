@@ -0,0 +1,213 @@
+#include "particles.h"
+#include "render.h"
+#include "sim/geometry.h"
+#include "sim/random.h"
+#include "sim/tank.h"
+#include "sim/terrain.h"
+
+#include <algorithm> // min, swap
+
+// constants
+#define PARTICLE_GRAVITY 400.0
+#define PARTICLE_WIND_SPEED 120.0
+#define MAX_PARTICLE_STEP_MS 100.0
+#define DIRT_PER_RADIUS 6
+#define SMOKE_PER_RADIUS 2
+#define WRECK_DEBRIS 40
+#define WRECK_SMOKE 30
+
+/**
+ * how each kind of particle is thrown and how it moves: speeds are in pixels
+ * a second, thrown up to spread degrees either side of straight up, and
+ * lives are in seconds
+ */
+struct particle_stats
+{
+    double weight;
+    double drift;
+    double min_speed;
+    double max_speed;
+    int spread;
+    double min_life;
+    double max_life;
+};
+
+// in particle_kind order
+const particle_stats PARTICLE_KINDS[] =
+{
+    { 1.0, 0.5, 60, 220, 60, 0.6, 1.2 },
+    { 1.0, 0.3, 80, 260, 80, 1.5, 2.5 },
+    { -0.1, 2.0, 10, 40, 50, 1.5, 3.0 }
+};
+
+// forward declarations
+void spawn_particle(particle_system &ps, particle_kind kind, const world_point &coords, color clr);
+double random_between(random_stream &r, double low, double high);
+void move_particles(int n, double dt, double gravity_step, double wind_speed, double *__restrict x,
+                    double *__restrict y, double *__restrict speed_x, double *__restrict speed_y,
+                    double *__restrict age, const double *__restrict weight,
+                    const double *__restrict drift);
+bool particle_done(const particle_system &ps, const terrain &t, int i);
+void swap_particles(particle_system &ps, int i, int j);
+
+particle_system new_particle_system(uint64_t seed)
+{
+    particle_system ps;
+
+    ps.count = 0;
+    ps.x.resize(MAX_PARTICLES);
+    ps.y.resize(MAX_PARTICLES);
+    ps.speed_x.resize(MAX_PARTICLES);
+    ps.speed_y.resize(MAX_PARTICLES);
+    ps.weight.resize(MAX_PARTICLES);
+    ps.drift.resize(MAX_PARTICLES);
+    ps.age.resize(MAX_PARTICLES);
+    ps.life.resize(MAX_PARTICLES);
+    ps.kind.resize(MAX_PARTICLES);
+    ps.clr.resize(MAX_PARTICLES);
+    ps.random = new_random_stream(seed, PARTICLE_STREAM);
+
+    return ps;
+}
+
+void spawn_explosion_particles(particle_system &ps, const world_point &coords, int radius)
+{
+    for ( int i = 0; i < radius * DIRT_PER_RADIUS; i++ )
+    {
+        spawn_particle(ps, DIRT_PARTICLE, coords, COLOR_GREEN);
+    }
+    for ( int i = 0; i < radius * SMOKE_PER_RADIUS; i++ )
+    {
+        spawn_particle(ps, SMOKE_PARTICLE, coords, COLOR_GRAY);
+    }
+}
+
+void spawn_wreck_particles(particle_system &ps, const tank &t)
+{
+    world_point center = tank_center(t);
+
+    for ( int i = 0; i < WRECK_DEBRIS; i++ )
+    {
+        spawn_particle(ps, DEBRIS_PARTICLE, center, tank_color(t));
+    }
+    for ( int i = 0; i < WRECK_SMOKE; i++ )
+    {
+        spawn_particle(ps, SMOKE_PARTICLE, center, COLOR_DARK_GRAY);
+    }
+}
+
+/**
+ * throw one particle out from a point, unless there is no room left for it
+ */
+void spawn_particle(particle_system &ps, particle_kind kind, const world_point &coords, color clr)
+{
+    if ( ps.count == MAX_PARTICLES ) return;
+
+    const particle_stats &stats = PARTICLE_KINDS[kind];
+    int angle = random_int(ps.random, 2 * stats.spread + 1) - stats.spread;
+    double speed = random_between(ps.random, stats.min_speed, stats.max_speed);
+    int i = ps.count++;
+
+    ps.x[i] = coords.x;
+    ps.y[i] = coords.y;
+    ps.speed_x[i] = speed * sin_deg(angle);
+    ps.speed_y[i] = -speed * cos_deg(angle);
+    ps.weight[i] = stats.weight;
+    ps.drift[i] = stats.drift;
+    ps.age[i] = 0;
+    ps.life[i] = random_between(ps.random, stats.min_life, stats.max_life);
+    ps.kind[i] = kind;
+    ps.clr[i] = clr;
+}
+
+/**
+ * a random double from low up to high
+ */
+double random_between(random_stream &r, double low, double high)
+{
+    return low + (high - low) * random_double(r);
+}
+
+/**
+ * Move everything first, then drop what is done. A long frame is cut short
+ * so nothing overshoots the wind it is easing into.
+ */
+void particles_tick(particle_system &ps, const terrain &t, double wind, double frame_ms)
+{
+    double dt = min(frame_ms, MAX_PARTICLE_STEP_MS) / 1000;
+
+    move_particles(ps.count, dt, PARTICLE_GRAVITY * dt, wind * PARTICLE_WIND_SPEED, ps.x.data(),
+                   ps.y.data(), ps.speed_x.data(), ps.speed_y.data(), ps.age.data(), ps.weight.data(),
+                   ps.drift.data());
+
+    int i = 0;
+    while ( i < ps.count )
+    {
+        if ( particle_done(ps, t, i) )
+        {
+            ps.count--;
+            swap_particles(ps, i, ps.count);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/**
+ * The moving kernel itself. Every kind moves by the same sums, with its
+ * weight and drift picking how much gravity and wind it feels, so there is
+ * no branch to stop the loop vectorizing. The arrays come in as restrict
+ * parameters so the compiler knows they never overlap.
+ */
+void move_particles(int n, double dt, double gravity_step, double wind_speed, double *__restrict x,
+                    double *__restrict y, double *__restrict speed_x, double *__restrict speed_y,
+                    double *__restrict age, const double *__restrict weight,
+                    const double *__restrict drift)
+{
+    for ( int i = 0; i < n; i++ )
+    {
+        speed_x[i] += (wind_speed - speed_x[i]) * drift[i] * dt;
+        speed_y[i] += gravity_step * weight[i];
+        x[i] += speed_x[i] * dt;
+        y[i] += speed_y[i] * dt;
+        age[i] += dt;
+    }
+}
+
+/**
+ * has a particle lived out its life, left the world, or come down on the
+ * ground? Smoke goes through the ground rather than landing on it.
+ */
+bool particle_done(const particle_system &ps, const terrain &t, int i)
+{
+    if ( ps.age[i] >= ps.life[i] or ps.x[i] < 0 or ps.x[i] >= t.width or ps.y[i] >= WORLD_HEIGHT )
+    {
+        return true;
+    }
+
+    world_point p;
+    p.x = ps.x[i];
+    p.y = ps.y[i];
+    return ps.weight[i] > 0 and ps.speed_y[i] > 0 and touches_ground(t, p);
+}
+
+/**
+ * swap everything about two particles
+ */
+void swap_particles(particle_system &ps, int i, int j)
+{
+    if ( i == j ) return;
+
+    swap(ps.x[i], ps.x[j]);
+    swap(ps.y[i], ps.y[j]);
+    swap(ps.speed_x[i], ps.speed_x[j]);
+    swap(ps.speed_y[i], ps.speed_y[j]);
+    swap(ps.weight[i], ps.weight[j]);
+    swap(ps.drift[i], ps.drift[j]);
+    swap(ps.age[i], ps.age[j]);
+    swap(ps.life[i], ps.life[j]);
+    swap(ps.kind[i], ps.kind[j]);
+    swap(ps.clr[i], ps.clr[j]);
+}
@@ -0,0 +1,49 @@
+#ifndef PARTICLES_H_
+#define PARTICLES_H_
+
+#include "shared.h"
+
+// the most particles in the air at once
+#define MAX_PARTICLES 8192
+
+/**
+ * Create and return a new particle system with room for MAX_PARTICLES and
+ * none live.
+ *
+ * @param    the seed for the particles' random stream
+ * @returns  the new particle system
+ */
+particle_system new_particle_system(uint64_t seed);
+
+/**
+ * Throw up dirt from a blast, and smoke that drifts off it, more for a
+ * bigger blast.
+ *
+ * @param    the particle system to spawn into
+ * @param    the center of the blast
+ * @param    the radius of the blast
+ */
+void spawn_explosion_particles(particle_system &ps, const world_point &coords, int radius);
+
+/**
+ * Throw bits of a destroyed tank about from its middle, with a plume of
+ * smoke.
+ *
+ * @param    the particle system to spawn into
+ * @param    the tank destroyed
+ */
+void spawn_wreck_particles(particle_system &ps, const tank &t);
+
+/**
+ * Move every particle on by some real time under gravity and the wind. Dirt
+ * and debris that come down on the ground, and particles that have lived
+ * out their life or left the world, are dropped.
+ *
+ * @param    the particle system to move
+ * @param    the terrain particles land on
+ * @param    the strength of the wind; negative is left and positive is right
+ * @param    how long since the last frame, in milliseconds
+ */
+void particles_tick(particle_system &ps, const terrain &t, double wind, double frame_ms);
+
+#endif
@@ -0,0 +1,319 @@
+#include "render.h"
+#include "sim/tank.h"
+#include "sim/terrain.h"
+
+#include <algorithm> // max, min
+
+// constants
+#define SHOT_RADIUS 3
+#define TERRAIN_TILE_SIZE 256
+#define EXPLOSION_BLACK_MS 5
+#define EXPLOSION_YELLOW_MS 10
+#define EXPLOSION_ORANGE_MS 20
+#define EXPLOSION_RING_MS (EXPLOSION_BLACK_MS + EXPLOSION_YELLOW_MS + EXPLOSION_ORANGE_MS)
+#define DIRT_SIZE 2
+#define DEBRIS_SIZE 3
+#define SMOKE_SIZE 3
+#define SMOKE_GROWTH 6
+
+// forward declarations
+color player_color(int id);
+bitmap tank_bmp(const tank &t);
+void draw_turret(const tank &t, const world_point &offset);
+void draw_terrain_tile(bitmap bmp, const terrain &t, int tile_x, int tile_y);
+void release_terrain_tiles(terrain_tiles &tiles, int first_tile, int last_tile);
+void draw_particle_kind(const particle_system &ps, particle_kind kind, int view_x);
+
+color tank_color(const tank &t)
+{
+    return t.alive ? player_color(t.id) : COLOR_BLACK;
+}
+
+/**
+ * Provide the color for a player based on their tank id.
+ */
+color player_color(int id)
+{
+    switch ( id )
+    {
+        case 1: return COLOR_BLUE;
+        case 2: return COLOR_RED;
+        case 3: return COLOR_ORANGE;
+        case 4:
+        default: return COLOR_PURPLE;
+    }
+}
+
+/**
+ * Fill a circle on a bitmap half it's size, so only a semicircle displays. The
+ * bitmap is created the first time a tank with this id and color is drawn.
+ */
+bitmap tank_bmp(const tank &t)
+{
+    string name = "tank" + to_string(t.id) + (t.alive ? "" : "_destroyed");
+
+    if ( not has_bitmap(name) )
+    {
+        bitmap bmp = create_bitmap(name, int(2 * TANK_RADIUS), int(TANK_RADIUS));
+        fill_circle_on_bitmap(bmp, tank_color(t), TANK_RADIUS, TANK_RADIUS, TANK_RADIUS);
+        return bmp;
+    }
+
+    return bitmap_named(name);
+}
+
+/**
+ * Everything is drawn moved by however far the tank is shown from where it is.
+ */
+void draw_tank(const tank &t, const world_point &coords)
+{
+    world_point offset;
+    offset.x = coords.x - t.coords.x;
+    offset.y = coords.y - t.coords.y;
+
+    draw_bitmap(tank_bmp(t), coords.x, coords.y, option_rotate_bmp(t.base_angle, 0, TANK_RADIUS / 2));
+    draw_turret(t, offset);
+}
+
+/**
+ * Draw 9 lines that make up the turret in a grid so it appears there is a 3
+ * pixel width block from any angle. Adjusts the base if the tank is on a
+ * large angle to make it appear more central.
+ */
+void draw_turret(const tank &t, const world_point &offset)
+{
+    world_point center = mid_base_point(t);
+    world_point end = turret_end_point(t, t.turret_angle);
+    color clr = tank_color(t);
+
+    center.x += offset.x;
+    center.y += offset.y;
+    end.x += offset.x;
+    end.y += offset.y;
+
+    if ( t.base_angle > 45 )
+    {
+        draw_line(clr, end.x + 1, end.y - 3, center.x + 1, center.y - 3);
+        draw_line(clr, end.x + 1, end.y - 2, center.x + 1, center.y - 2);
+        draw_line(clr, end.x + 1, end.y - 1, center.x + 1, center.y - 1);
+        draw_line(clr, end.x + 2, end.y - 3, center.x + 2, center.y - 3);
+        draw_line(clr, end.x + 2, end.y - 2, center.x + 2, center.y - 2);
+        draw_line(clr, end.x + 2, end.y - 1, center.x + 2, center.y - 1);
+    }
+    else if ( t.base_angle < -45 )
+    {
+        draw_line(clr, end.x - 2, end.y - 3, center.x - 2, center.y - 3);
+        draw_line(clr, end.x - 2, end.y - 2, center.x - 2, center.y - 2);
+        draw_line(clr, end.x - 2, end.y - 1, center.x - 2, center.y - 1);
+        draw_line(clr, end.x - 1, end.y - 3, center.x - 1, center.y - 3);
+        draw_line(clr, end.x - 1, end.y - 2, center.x - 1, center.y - 2);
+        draw_line(clr, end.x - 1, end.y - 1, center.x - 1, center.y - 1);
+    }
+    else
+    {
+        draw_line(clr, end.x - 1, end.y - 3, center.x - 1, center.y - 3);
+        draw_line(clr, end.x - 1, end.y - 2, center.x - 1, center.y - 2);
+        draw_line(clr, end.x - 1, end.y - 1, center.x - 1, center.y - 1);
+        draw_line(clr, end.x + 1, end.y - 3, center.x + 1, center.y - 3);
+        draw_line(clr, end.x + 1, end.y - 2, center.x + 1, center.y - 2);
+        draw_line(clr, end.x + 1, end.y - 1, center.x + 1, center.y - 1);
+    }
+    draw_line(clr, end.x, end.y - 3, center.x, center.y - 3);
+    draw_line(clr, end.x, end.y - 2, center.x, center.y - 2);
+    draw_line(clr, end.x, end.y - 1, center.x, center.y - 1);
+}
+
+terrain_tiles new_terrain_tiles(const terrain &t)
+{
+    terrain_tiles tiles;
+    terrain_tile empty;
+
+    empty.bmp = NULL;
+    empty.dirty = false;
+    tiles.columns = (t.width + TERRAIN_TILE_SIZE - 1) / TERRAIN_TILE_SIZE;
+    tiles.rows = (WORLD_HEIGHT + TERRAIN_TILE_SIZE - 1) / TERRAIN_TILE_SIZE;
+    tiles.tiles.assign(tiles.columns * tiles.rows, empty);
+
+    return tiles;
+}
+
+void mark_terrain_dirty(terrain_tiles &tiles, int first_column, int last_column)
+{
+    int first_tile = max(first_column / TERRAIN_TILE_SIZE, 0);
+    int last_tile = min(last_column / TERRAIN_TILE_SIZE, tiles.columns - 1);
+
+    for ( int column = first_tile; column <= last_tile; column++ )
+    {
+        for ( int row = 0; row < tiles.rows; row++ )
+        {
+            tiles.tiles[column * tiles.rows + row].dirty = true;
+        }
+    }
+}
+
+void draw_terrain(terrain_tiles &tiles, const terrain &t, int view_x)
+{
+    int first_tile = max(view_x / TERRAIN_TILE_SIZE, 0);
+    int last_tile = min((view_x + WINDOW_WIDTH - 1) / TERRAIN_TILE_SIZE, tiles.columns - 1);
+
+    for ( int column = first_tile; column <= last_tile; column++ )
+    {
+        int x = column * TERRAIN_TILE_SIZE;
+        int highest = highest_ground(t, x, x + TERRAIN_TILE_SIZE - 1);
+
+        for ( int row = 0; row < tiles.rows; row++ )
+        {
+            int y = row * TERRAIN_TILE_SIZE;
+            terrain_tile &tile = tiles.tiles[column * tiles.rows + row];
+
+            // open sky is just the background showing through
+            if ( y + TERRAIN_TILE_SIZE <= highest ) continue;
+
+            if ( not tile.bmp )
+            {
+                string name = "terrain" + to_string(column) + "_" + to_string(row);
+                tile.bmp = create_bitmap(name, TERRAIN_TILE_SIZE, TERRAIN_TILE_SIZE);
+                tile.dirty = true;
+                tiles.made.push_back(column * tiles.rows + row);
+            }
+            if ( tile.dirty )
+            {
+                draw_terrain_tile(tile.bmp, t, x, y);
+                tile.dirty = false;
+            }
+            draw_bitmap(tile.bmp, x, y);
+        }
+    }
+
+    release_terrain_tiles(tiles, first_tile - 1, last_tile + 1);
+}
+
+/**
+ * Draw one tile's square of the terrain onto its bitmap, each run of dirt in
+ * each column cut down to the rows the tile covers.
+ */
+void draw_terrain_tile(bitmap bmp, const terrain &t, int tile_x, int tile_y)
+{
+    clear_bitmap(bmp, BACKGROUND_COLOR);
+    for ( int x = tile_x; x < min(tile_x + TERRAIN_TILE_SIZE, t.width); x++ )
+    {
+        const terrain_span *span, *last;
+        for ( column_span_range(t, x, span, last); span < last; span++ )
+        {
+            int top = max(span->top, tile_y);
+            int bottom = min(span->bottom, tile_y + TERRAIN_TILE_SIZE);
+            if ( top < bottom )
+            {
+                draw_line_on_bitmap(bmp, COLOR_GREEN, x - tile_x, top - tile_y, x - tile_x, bottom - 1 - tile_y);
+            }
+        }
+    }
+}
+
+/**
+ * Give up the bitmaps of tiles outside a range of tile columns. Only tiles that
+ * have a bitmap are looked at.
+ */
+void release_terrain_tiles(terrain_tiles &tiles, int first_tile, int last_tile)
+{
+    int i = 0;
+    while ( i < tiles.made.size() )
+    {
+        int column = tiles.made[i] / tiles.rows;
+        if ( column < first_tile or column > last_tile )
+        {
+            terrain_tile &tile = tiles.tiles[tiles.made[i]];
+            free_bitmap(tile.bmp);
+            tile.bmp = NULL;
+            tiles.made[i] = tiles.made.back();
+            tiles.made.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void free_terrain_tiles(terrain_tiles &tiles)
+{
+    release_terrain_tiles(tiles, 0, -1);
+}
+
+void draw_shot(const shot &s)
+{
+    fill_circle(player_color(s.owner_id), s.coords.x, max(0.0, s.coords.y), SHOT_RADIUS);
+}
+
+explosion_animation new_explosion_animation(const world_point &coords, int radius)
+{
+    explosion_animation e;
+
+    e.coords = coords;
+    e.radius = radius;
+    e.age_ms = 0;
+
+    return e;
+}
+
+bool explosion_finished(const explosion_animation &e)
+{
+    return e.age_ms >= e.radius * EXPLOSION_RING_MS;
+}
+
+/**
+ * Each ring of the explosion flashes black, then yellow, then settles on
+ * orange before the next, larger, ring starts.
+ */
+void draw_explosion(const explosion_animation &e)
+{
+    int ring = int(e.age_ms / EXPLOSION_RING_MS);
+    double ring_age = e.age_ms - ring * EXPLOSION_RING_MS;
+    color clr;
+
+    if ( ring_age < EXPLOSION_BLACK_MS )
+    {
+        clr = COLOR_BLACK;
+    }
+    else if ( ring_age < EXPLOSION_BLACK_MS + EXPLOSION_YELLOW_MS )
+    {
+        clr = COLOR_YELLOW;
+    }
+    else
+    {
+        clr = COLOR_ORANGE;
+    }
+
+    fill_circle(clr, e.coords.x, e.coords.y, min(ring, e.radius - 1));
+}
+
+/**
+ * Smoke goes down first so dirt and debris show in front of it, and each
+ * kind is then drawn in one run over the particles.
+ */
+void draw_particles(const particle_system &ps, int view_x)
+{
+    draw_particle_kind(ps, SMOKE_PARTICLE, view_x);
+    draw_particle_kind(ps, DEBRIS_PARTICLE, view_x);
+    draw_particle_kind(ps, DIRT_PARTICLE, view_x);
+}
+
+/**
+ * draw every particle of one kind that is in view; smoke spreads as it fades
+ */
+void draw_particle_kind(const particle_system &ps, particle_kind kind, int view_x)
+{
+    double size = ( kind == DIRT_PARTICLE ) ? DIRT_SIZE : ( kind == DEBRIS_PARTICLE ) ? DEBRIS_SIZE : SMOKE_SIZE;
+    double growth = ( kind == SMOKE_PARTICLE ) ? SMOKE_GROWTH : 0;
+
+    for ( int i = 0; i < ps.count; i++ )
+    {
+        if ( ps.kind[i] != kind or ps.x[i] < view_x or ps.x[i] >= view_x + WINDOW_WIDTH ) continue;
+
+        double faded = ps.age[i] / ps.life[i];
+        double shown = size + growth * faded;
+        color clr = ps.clr[i];
+        clr.a = 1 - faded;
+        fill_rectangle(clr, ps.x[i] - shown / 2, ps.y[i] - shown / 2, shown, shown);
+    }
+}
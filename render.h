@@ -0,0 +1,102 @@
+#ifndef RENDER_H_
+#define RENDER_H_
+
+#include "shared.h"
+
+/**
+ * The color a tank is drawn in, based on its id. Destroyed tanks are black.
+ *
+ * @param    the tank
+ * @returns  the color to draw it with
+ */
+color tank_color(const tank &t);
+
+/**
+ * Draw the tank on the window, at the given coordinates rather than its own
+ * so it can be shown part way between ticks without being copied.
+ *
+ * @param    the tank to be drawn
+ * @param    where to draw it
+ */
+void draw_tank(const tank &t, const world_point &coords);
+
+/**
+ * Create the tiles for a terrain's image. No tile has a bitmap yet; each is
+ * made the first time it is drawn.
+ *
+ * @param    the terrain the image is of
+ * @returns  the new, empty tiles
+ */
+terrain_tiles new_terrain_tiles(const terrain &t);
+
+/**
+ * Mark the tiles over some columns as needing to be drawn again, because the
+ * terrain in them has changed. Nothing is drawn until they are next on screen.
+ *
+ * @param    the tiles of the terrain image
+ * @param    the first column that changed
+ * @param    the last column that changed
+ */
+void mark_terrain_dirty(terrain_tiles &tiles, int first_column, int last_column);
+
+/**
+ * Draw the terrain in view. Only tiles on screen are looked at: those with
+ * ground in them get a bitmap if they don't have one and are redrawn if they
+ * are dirty, and tiles of open sky are left to the background. Tiles that
+ * have scrolled well out of view give their bitmaps up, so memory follows
+ * what is on screen rather than the size of the world.
+ *
+ * @param    the tiles of the terrain image
+ * @param    the terrain to draw
+ * @param    the world column at the left edge of the window
+ */
+void draw_terrain(terrain_tiles &tiles, const terrain &t, int view_x);
+
+/**
+ * Let go of every tile bitmap.
+ *
+ * @param    the tiles of the terrain image
+ */
+void free_terrain_tiles(terrain_tiles &tiles);
+
+/**
+ * Draw the shot on the window. If the shot is above the top of the window,
+ * it tracks along the top of the screen.
+ *
+ * @param    the shot to be drawn
+ */
+void draw_shot(const shot &s);
+
+/**
+ * Create a new explosion animation, ready to be aged and drawn each frame.
+ *
+ * @param    the center of the explosion
+ * @param    the radius the explosion grows to
+ * @returns  the new animation
+ */
+explosion_animation new_explosion_animation(const world_point &coords, int radius);
+
+/**
+ * Has the explosion animation finished playing?
+ *
+ * @param    the explosion animation
+ * @returns  whether it is over
+ */
+bool explosion_finished(const explosion_animation &e);
+
+/**
+ * Draw a sweet explosion, as far through as it has aged.
+ *
+ * @param    the explosion animation to draw
+ */
+void draw_explosion(const explosion_animation &e);
+
+/**
+ * Draw the particles in view, fading each out over its life.
+ *
+ * @param    the particle system to draw
+ * @param    the world column at the left edge of the window
+ */
+void draw_particles(const particle_system &ps, int view_x);
+
+#endif
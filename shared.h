@@ -2,6 +2,7 @@
 #define SHARED_H_ 
 
 #include "splashkit.h"
+#include "sim/sim.h"
 
 using namespace std;
 
@@ -0,0 +1,418 @@
+#include "brain.h"
+#include "tank.h"
+#include "geometry.h"
+#include "random.h"
+#include "world.h"
+#include "shot_search.h"
+#include "firing_table.h"
+
+#include <algorithm> // max, min
+#include <cstdlib>   // abs int
+#include <cmath>     // abs double, geometry
+#include <chrono>    // wait_for
+#include <future>    // async
+
+#define LONG_RANGE 200
+#define MEDIUM_RANGE 100
+#define ANGLE_THRESHOLD 120
+
+// forward declarations
+void make_decision(world &w);
+brain_decision decide(world snapshot);
+void apply_decision(world &w, const brain_decision &d);
+void pick_target(world &w);
+void set_target_angle(world &w);
+void set_target_power(world &w);
+void adjust_angle(world &w, tank &t);
+void adjust_power(world &w, tank &t);
+bool aim_step(world &w, tank &t);
+bool on_target(const tank &t);
+void adjust_for_wind(double &d, double wind);
+void adjust_for_angle(double &power, int angle);
+void adjust_aiming(world &w);
+void bound_targets(tank &active_tank);
+int distance_x(const tank *t1, const tank &t2);
+bool no_or_dead_target(const tank *target);
+double aim_adjustment(const tank &active_tank);
+
+brain new_brain()
+{
+    brain b;
+
+    b.state = WAITING;
+    b.variant = CLASSIC_BRAIN;
+    b.aim_speed = AI_AIM_SPEED;
+    b.aim_budget = 0;
+    b.think_async = false;
+    b.table = new_firing_table();
+    b.target = NULL;
+    b.last_shot = NULL;
+
+    return b;
+}
+
+void think(world &w)
+{
+    brain &b = w.active_tank->ai;
+
+    if ( b.pending.valid() )
+    {
+        if ( b.pending.wait_for(chrono::seconds(0)) == future_status::ready )
+        {
+            apply_decision(w, b.pending.get());
+            b.pending = shared_future<brain_decision>();
+            b.state = READY;
+        }
+    }
+    else if ( not falling(*(w.active_tank), w.game_terrain) )
+    {
+        if ( b.think_async )
+        {
+            b.pending = async(launch::async, decide, copy_world(w)).share();
+        }
+        else
+        {
+            make_decision(w);
+            b.state = READY;
+        }
+    }
+}
+
+/**
+ * work out the target, angle and power for the active tank
+ */
+void make_decision(world &w)
+{
+    if ( w.active_tank->ai.variant == SEARCH_BRAIN )
+    {
+        brain &b = w.active_tank->ai;
+        pick_target(w);
+        search_shot(w, *(w.active_tank), *(b.target), b.table, b.target_angle, b.target_power);
+    }
+    else if ( no_or_dead_target(w.active_tank->ai.target) or w.active_tank->ai.variant == NAIVE_BRAIN )
+    {
+        pick_target(w);
+        set_target_angle(w);
+        set_target_power(w);
+    }
+    else
+    {
+        adjust_aiming(w);
+    }
+
+    bound_targets(*(w.active_tank));
+}
+
+/**
+ * Runs on a worker thread. The snapshot is the worker's own copy of the world,
+ * so the decision can be made on it freely and handed back.
+ */
+brain_decision decide(world snapshot)
+{
+    make_decision(snapshot);
+
+    brain &b = snapshot.active_tank->ai;
+    brain_decision d;
+    d.target_id = b.target ? b.target->id : 0;
+    d.target_angle = b.target_angle;
+    d.target_power = b.target_power;
+    d.random = b.random;
+    d.table = move(b.table);
+
+    return d;
+}
+
+/**
+ * Copy a decision made on a snapshot onto the active tank's brain. If terrain
+ * or tanks changed while the worker was busy, the table it refreshed is
+ * already out of date, so the brain keeps its own with the newer stale marks.
+ */
+void apply_decision(world &w, const brain_decision &d)
+{
+    brain &b = w.active_tank->ai;
+
+    b.target = d.target_id ? &(w.tanks[d.target_id - 1]) : NULL;
+    b.target_angle = d.target_angle;
+    b.target_power = d.target_power;
+    b.random = d.random;
+    if ( d.table.revision == b.table.revision )
+    {
+        b.table = d.table;
+    }
+}
+
+/**
+ * picks a victim^H^H^H^H^H^Htarget to fire at
+ */
+void pick_target(world &w)
+{
+    int d;
+    int closest = w.game_terrain.width;
+
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        if ( w.tanks[i].id != w.active_tank->id and w.tanks[i].alive )
+        {
+            d = distance_x(w.active_tank, w.tanks[i]);
+            if ( abs(d) < closest )
+            {
+                w.active_tank->ai.target = &(w.tanks[i]);
+                closest = d;
+            }
+        }
+    }
+}
+
+/**
+ * sets an initial target angle estimate for a new target
+ */
+void set_target_angle(world &w)
+{
+    int d = distance_x(w.active_tank, *(w.active_tank->ai.target));
+    int angle;
+
+    if ( d > LONG_RANGE )
+    {
+        angle = 55;
+    }
+    else if ( d > MEDIUM_RANGE )
+    {
+        angle = 65;
+    }
+    else if ( d > 0 )
+    {
+        angle = 80;
+    }
+    else if ( d > -MEDIUM_RANGE )
+    {
+        angle = 100;
+    }
+    else if ( d < -LONG_RANGE )
+    {
+        angle = 115;
+    }
+    else
+    {
+        angle = 125;
+    }
+
+    // random element for realism feel
+    angle += random_int(w.active_tank->ai.random, 11) - 5;
+        
+    w.active_tank->ai.target_angle = angle;
+}
+
+/**
+ * sets an initial target power estimate for a new target
+ */
+void set_target_power(world &w)
+{
+    double d = distance_x(w.active_tank, *(w.active_tank->ai.target));
+    adjust_for_wind(d, w.wind_strength);
+
+    double power = sqrt(8 * abs(d));
+    adjust_for_angle(power, w.active_tank->ai.target_angle);
+    
+    w.active_tank->ai.target_power = int(power);
+}
+
+/**
+ * adjust distance for wind
+ */
+void adjust_for_wind(double &d, double wind)
+{
+    if ( abs(d + wind) > abs(d) )
+    {
+        d /= (1 + abs(wind));
+    }
+    else
+    {
+        d *= (1 + abs(wind));
+    }
+}
+
+/**
+ * adjust power for angle
+ */
+void adjust_for_angle(double &power, int angle)
+{
+    angle -= 90;
+    angle = abs(angle);
+    angle -= 45;
+    angle = abs(angle);
+    angle *= 2;
+    power *= 1 + sin_deg(angle) / 2;
+}
+
+/**
+ * adjust the target angle by angle and power
+ */
+void adjust_aiming(world &w)
+{
+    double adjustment = aim_adjustment(*(w.active_tank));
+
+    if ( adjustment > ANGLE_THRESHOLD )
+    {
+        if ( w.active_tank->turret_angle > 45 )
+        {
+            adjustment -= ANGLE_THRESHOLD;
+            w.active_tank->ai.target_angle--;
+        }
+        else if ( w.active_tank->turret_angle < 45 )
+        {
+            adjustment -= ANGLE_THRESHOLD;
+            w.active_tank->ai.target_angle++;
+        }
+    }
+    if ( adjustment < -ANGLE_THRESHOLD )
+    {
+        if ( w.active_tank->turret_angle > 135 )
+        {
+            adjustment += ANGLE_THRESHOLD;
+            w.active_tank->ai.target_angle--;
+        }
+        else if ( w.active_tank->turret_angle < 135 )
+        {
+            adjustment += ANGLE_THRESHOLD;
+            w.active_tank->ai.target_angle++;
+        }
+    }
+    if ( adjustment > 0 )
+    {
+        w.active_tank->ai.target_power += int(sqrt(adjustment));
+    }
+    else
+    {
+        w.active_tank->ai.target_power -= int(sqrt(abs(adjustment)));
+    }
+}
+
+/**
+ * bound to within tank limits
+ */
+void bound_targets(tank &active_tank)
+{
+    active_tank.ai.target_angle = max(active_tank.ai.target_angle,
+                                      TANK_MIN_ANGLE + active_tank.base_angle + 2);
+    active_tank.ai.target_angle = min(active_tank.ai.target_angle,
+                                      TANK_MAX_ANGLE - active_tank.base_angle - 2);
+
+    active_tank.ai.target_power = max(active_tank.ai.target_power, TANK_MIN_POWER);
+    active_tank.ai.target_power = min(active_tank.ai.target_power, TANK_MAX_POWER);
+}
+
+void act(world &w)
+{
+    tank *t = w.active_tank;
+
+    if ( t->ai.aim_speed == INSTANT_AIM )
+    {
+        while ( aim_step(w, *t) );
+    }
+    else
+    {
+        // the turret moves at a steady rate in simulation time, so a tick only
+        // gets as many one unit steps as the time it covers pays for
+        t->ai.aim_budget += t->ai.aim_speed * TICK_SECONDS;
+        while ( t->ai.aim_budget >= 1 and aim_step(w, *t) )
+        {
+            t->ai.aim_budget--;
+        }
+    }
+
+    if ( on_target(*t) )
+    {
+        t->ai.state = WAITING;
+        t->ai.aim_budget = 0;
+        shoot(w, *t);
+        t->ai.last_shot = &(t->active_shot);
+    }
+}
+
+/**
+ * move the turret one unit towards the target, angle first and then power.
+ * Returns false if there was nothing left to move.
+ */
+bool aim_step(world &w, tank &t)
+{
+    if ( t.turret_angle != t.ai.target_angle )
+    {
+        adjust_angle(w, t);
+    }
+    else if ( t.power != t.ai.target_power )
+    {
+        adjust_power(w, t);
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * is the turret where the brain wants it?
+ */
+bool on_target(const tank &t)
+{
+    return t.turret_angle == t.ai.target_angle and t.power == t.ai.target_power;
+}
+
+/**
+ * adjust the angle by one increment towards the target angle
+ */
+void adjust_angle(world &w, tank &t)
+{
+    ( t.turret_angle > t.ai.target_angle ) ? angle_down(w, t) : angle_up(w, t);
+}
+
+/**
+ * adjust the power by one increment towards the target power
+ */
+void adjust_power(world &w, tank &t)
+{
+    ( t.power > t.ai.target_power ) ? power_down(w, t) : power_up(w, t);
+}
+
+/**
+ * return the horizontal distance between two tanks
+ */
+int distance_x(const tank *t1, const tank &t2)
+{
+    int d = int(max(t1->coords.x, t2.coords.x) - min(t1->coords.x, t2.coords.x));
+
+    return ( t1->coords.x > t2.coords.x ) ? -d : d;
+}
+
+/**
+ * is there no target, or a dead target?
+ */
+bool no_or_dead_target(const tank *target)
+{
+    return !target or not target->alive;
+}
+
+/**
+ * calculate the aim adjustment factor
+ */
+double aim_adjustment(const tank &active_tank)
+{
+    world_point source = active_tank.coords;
+    world_point target = tank_center(*(active_tank.ai.target));
+    world_point shot = active_tank.ai.last_shot->coords;
+
+    double d;
+    if ( (source.x < target.x and shot.x < target.x) or
+         (source.x < target.x and shot.x > target.x) )
+    {
+        d = target.x - shot.x + (shot.y - target.y) / 4;
+    }
+    // lets be explicit because this is hard
+    else if ( (source.x > target.x and shot.x < target.x) or
+              (source.x > target.x and shot.x > target.x) )
+    {
+        d = shot.x - target.x + (shot.y - target.y) / 4;
+    }
+
+    return d;
+}
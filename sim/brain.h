@@ -0,0 +1,34 @@
+#ifndef BRAIN_H_
+#define BRAIN_H_ 
+
+#include "sim.h"
+
+// turret units (degrees or power) an ai moves per second of simulation time
+#define AI_AIM_SPEED 50.0
+#define INSTANT_AIM 0.0
+
+/**
+ * Create and return a new brain for a tank's ai to use.
+ *
+ * @returns  the new brain
+ */
+brain new_brain();
+
+/**
+ * The active tank thinks about things for a little while. Brains that think
+ * asynchronously work on a copy of the world on a worker thread, and each call
+ * just checks whether they have finished; others decide straight away. The
+ * brain is READY once it has decided.
+ *
+ * @param   the world containing the active tank
+ */
+void think(world &w);
+
+/**
+ * The active tank acts on its decision! No procrastination here.
+ *
+ * @param   the world containing the active tank
+ */
+void act(world &w);
+
+#endif
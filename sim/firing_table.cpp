@@ -0,0 +1,244 @@
+#include "firing_table.h"
+#include "tank.h"
+#include "shot.h"
+#include "shot_batch.h"
+
+#include <algorithm> // max, min
+#include <cmath>     // floor, ceil, lround
+
+// forward declarations
+bool firing_table_matches(const tank &shooter, int wind_bucket, const firing_table &table);
+void build_firing_table(const tank &shooter, int wind_bucket, int width, firing_table &table);
+void file_entry(firing_table &table, int index, int width);
+int column_bucket(int column, int width);
+int wind_bucket(double wind);
+
+firing_table new_firing_table()
+{
+    firing_table table;
+
+    table.shooter_coords.x = 0;
+    table.shooter_coords.y = 0;
+    table.base_angle = 0;
+    table.wind_bucket = 0;
+    table.revision = 0;
+    table.batch = new_shot_batch();
+
+    return table;
+}
+
+/**
+ * Every wanted stale entry flies in one batch, and shots are indexed in the
+ * order added. An entry is marked fresh as it is added so a repeat isn't
+ * added twice.
+ */
+void refresh_firing_table(const world &w, const tank &shooter, firing_table &table,
+                          const vector<int> &wanted)
+{
+    int bucket = wind_bucket(w.wind_strength);
+
+    if ( not firing_table_matches(shooter, bucket, table) )
+    {
+        build_firing_table(shooter, bucket, w.game_terrain.width, table);
+    }
+
+    shot_batch &b = table.batch;
+    vector<int> &traced = table.traced;
+    clear_shot_batch(b);
+    traced.clear();
+    for ( int i = 0; i < wanted.size(); i++ )
+    {
+        firing_entry &e = table.entries[wanted[i]];
+        if ( not e.stale ) continue;
+
+        shot s = new_aimed_shot(shooter, e.angle, e.power);
+        add_to_shot_batch(b, s);
+        e.left = int(floor(s.initial_x));
+        e.right = int(ceil(s.initial_x));
+        e.stale = false;
+        e.trace++;
+        traced.push_back(wanted[i]);
+    }
+    trace_shot_batch(w, b, bucket * FIRING_WIND_STEP);
+
+    // a shot's x moves by the same amount every step, so it flies across
+    // exactly the columns between where it started and where it ended up
+    for ( int s = 0; s < traced.size(); s++ )
+    {
+        firing_entry &e = table.entries[traced[s]];
+        e.landed = b.landed[s];
+        e.exploded = b.exploded[s];
+        e.left = min(e.left, int(floor(e.landed.x)));
+        e.right = max(e.right, int(ceil(e.landed.x)));
+        file_entry(table, traced[s], w.game_terrain.width);
+    }
+}
+
+/**
+ * file a freshly traced entry under every bucket it belongs in
+ */
+void file_entry(firing_table &table, int index, int width)
+{
+    const firing_entry &e = table.entries[index];
+    firing_filing f;
+    f.entry = index;
+    f.trace = e.trace;
+
+    if ( e.exploded )
+    {
+        table.landings[column_bucket(int(e.landed.x), width)].push_back(f);
+    }
+    for ( int k = column_bucket(e.left, width); k <= column_bucket(e.right, width); k++ )
+    {
+        table.crossings[k].push_back(f);
+    }
+}
+
+/**
+ * Which bucket is a column filed in? Columns off either side of the world
+ * share the bucket at that edge.
+ */
+int column_bucket(int column, int width)
+{
+    return max(0, min(column, width - 1)) / FIRING_BUCKET_COLUMNS;
+}
+
+int firing_entry_index(const tank &shooter, int angle, int power)
+{
+    int min_angle = TANK_MIN_ANGLE + shooter.base_angle + 2;
+    int powers = (TANK_MAX_POWER - TANK_MIN_POWER) / FIRING_POWER_STEP + 1;
+
+    return (angle - min_angle) / FIRING_ANGLE_STEP * powers + (power - TANK_MIN_POWER) / FIRING_POWER_STEP;
+}
+
+/**
+ * Only the buckets the columns are filed in are looked through. Filings that
+ * are out of date, or for entries that are already stale, are dropped on the
+ * way, and so are the entries made stale, since they are filed again when
+ * they are traced again.
+ */
+void invalidate_landings(world &w, int left, int right)
+{
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        firing_table &table = w.tanks[i].ai.table;
+        if ( table.entries.empty() ) continue;
+
+        int width = w.game_terrain.width;
+        for ( int k = column_bucket(left, width); k <= column_bucket(right, width); k++ )
+        {
+            vector<firing_filing> &bucket = table.landings[k];
+            int kept = 0;
+            for ( int j = 0; j < bucket.size(); j++ )
+            {
+                firing_entry &e = table.entries[bucket[j].entry];
+                if ( e.stale or e.trace != bucket[j].trace ) continue;
+
+                int column = int(e.landed.x);
+                if ( column >= left and column <= right )
+                {
+                    e.stale = true;
+                    continue;
+                }
+                bucket[kept++] = bucket[j];
+            }
+            bucket.resize(kept);
+        }
+        table.revision++;
+    }
+}
+
+/**
+ * looked through a bucket at a time, as invalidate_landings is
+ */
+void invalidate_crossings(world &w, int left, int right)
+{
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        firing_table &table = w.tanks[i].ai.table;
+        if ( table.entries.empty() ) continue;
+
+        int width = w.game_terrain.width;
+        for ( int k = column_bucket(left, width); k <= column_bucket(right, width); k++ )
+        {
+            vector<firing_filing> &bucket = table.crossings[k];
+            int kept = 0;
+            for ( int j = 0; j < bucket.size(); j++ )
+            {
+                firing_entry &e = table.entries[bucket[j].entry];
+                if ( e.stale or e.trace != bucket[j].trace ) continue;
+
+                if ( e.left <= right and e.right >= left )
+                {
+                    e.stale = true;
+                    continue;
+                }
+                bucket[kept++] = bucket[j];
+            }
+            bucket.resize(kept);
+        }
+        table.revision++;
+    }
+}
+
+/**
+ * was this table made for the tank where it is now and this wind?
+ */
+bool firing_table_matches(const tank &shooter, int wind_bucket, const firing_table &table)
+{
+    return not table.entries.empty() and
+           table.shooter_coords.x == shooter.coords.x and
+           table.shooter_coords.y == shooter.coords.y and
+           table.base_angle == shooter.base_angle and
+           table.wind_bucket == wind_bucket;
+}
+
+/**
+ * Lay out a fresh table with every stale entry the tank can aim at, using
+ * the same angle limits bound_targets keeps brains inside, and empty buckets
+ * to file them in.
+ */
+void build_firing_table(const tank &shooter, int wind_bucket, int width, firing_table &table)
+{
+    int min_angle = TANK_MIN_ANGLE + shooter.base_angle + 2;
+    int max_angle = TANK_MAX_ANGLE - shooter.base_angle - 2;
+
+    table.shooter_coords = shooter.coords;
+    table.base_angle = shooter.base_angle;
+    table.wind_bucket = wind_bucket;
+    table.entries.clear();
+
+    for ( int a = min_angle; a <= max_angle; a += FIRING_ANGLE_STEP )
+    {
+        for ( int p = TANK_MIN_POWER; p <= TANK_MAX_POWER; p += FIRING_POWER_STEP )
+        {
+            firing_entry e;
+            e.angle = a;
+            e.power = p;
+            e.landed = shooter.coords;
+            e.exploded = false;
+            e.stale = true;
+            e.left = 0;
+            e.right = 0;
+            e.trace = 0;
+            table.entries.push_back(e);
+        }
+    }
+
+    int buckets = column_bucket(width - 1, width) + 1;
+    table.landings.resize(buckets);
+    table.crossings.resize(buckets);
+    for ( int k = 0; k < buckets; k++ )
+    {
+        table.landings[k].clear();
+        table.crossings[k].clear();
+    }
+}
+
+/**
+ * which bucket of wind is this?
+ */
+int wind_bucket(double wind)
+{
+    return int(lround(wind / FIRING_WIND_STEP));
+}
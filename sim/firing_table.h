@@ -0,0 +1,71 @@
+#ifndef FIRING_TABLE_H_
+#define FIRING_TABLE_H_
+
+#include "sim.h"
+
+// a firing table holds every FIRING_ANGLE_STEP degrees by every
+// FIRING_POWER_STEP units of power the tank can reach
+#define FIRING_ANGLE_STEP 1
+#define FIRING_POWER_STEP 1
+
+// winds within the same FIRING_WIND_STEP share a table
+#define FIRING_WIND_STEP 0.05
+
+// entries are filed by column in buckets this many columns wide
+#define FIRING_BUCKET_COLUMNS 32
+
+/**
+ * Create and return a new, empty firing table.
+ *
+ * @returns  the new firing table
+ */
+firing_table new_firing_table();
+
+/**
+ * Bring some entries of a tank's firing table up to date. If the tank has
+ * moved, tilted or the wind has changed bucket the table is laid out afresh
+ * with every entry stale; then the wanted entries that are stale are traced,
+ * all in one batch. Entries that aren't wanted are left as they are.
+ *
+ * @param    the world the tank is in
+ * @param    the tank the table is for
+ * @param    the table to bring up to date
+ * @param    the indexes of the entries wanted, which may repeat
+ */
+void refresh_firing_table(const world &w, const tank &shooter, firing_table &table,
+                          const vector<int> &wanted);
+
+/**
+ * Where an angle and power are kept in the tank's firing table. Tables are
+ * laid out an angle at a time, from the lowest angle the tank can aim at,
+ * with every power in each.
+ *
+ * @param    the tank the table is for
+ * @param    the angle of the shot, one the tank can aim at
+ * @param    the power of the shot
+ * @returns  the index of the shot's entry
+ */
+int firing_entry_index(const tank &shooter, int angle, int power);
+
+/**
+ * Dirt has been removed from some columns. Removing dirt can only let shots
+ * fly further, so the only entries that can change are those that landed in
+ * these columns, and every firing table in the world forgets just those.
+ *
+ * @param    the world whose tables are affected
+ * @param    the leftmost column changed
+ * @param    the rightmost column changed
+ */
+void invalidate_landings(world &w, int left, int right);
+
+/**
+ * A tank has moved across some columns. Any shot that flies across them might
+ * now hit it or miss it, so every firing table in the world forgets those.
+ *
+ * @param    the world whose tables are affected
+ * @param    the leftmost column changed
+ * @param    the rightmost column changed
+ */
+void invalidate_crossings(world &w, int left, int right);
+
+#endif
@@ -0,0 +1,161 @@
+#include "geometry.h"
+
+#include <cmath>  // sqrt
+#include <limits> // infinity
+
+// constants
+#define TRIG_MIN_DEGREES -180
+#define TRIG_MAX_DEGREES 360
+#define TRIG_TABLE_SIZE (TRIG_MAX_DEGREES - TRIG_MIN_DEGREES + 1)
+#define TAYLOR_TERMS 14
+#define PI_LONG 3.141592653589793238462643383279502884L
+
+/**
+ * The trig values of every whole degree from TRIG_MIN_DEGREES to
+ * TRIG_MAX_DEGREES, which covers every angle the simulation works with
+ * without wrapping.
+ */
+struct trig_table
+{
+    double sin[TRIG_TABLE_SIZE];
+    double cos[TRIG_TABLE_SIZE];
+    double tan[TRIG_TABLE_SIZE];
+    double sec2[TRIG_TABLE_SIZE];
+};
+
+// forward declarations
+int trig_index(int degrees);
+
+/**
+ * taylor series for sine, which is plenty accurate up to 45 degrees
+ */
+constexpr long double taylor_sin(long double radians)
+{
+    long double term = radians;
+    long double sum = radians;
+    for ( int n = 1; n <= TAYLOR_TERMS; n++ )
+    {
+        term *= -radians * radians / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * taylor series for cosine, which is plenty accurate up to 45 degrees
+ */
+constexpr long double taylor_cos(long double radians)
+{
+    long double term = 1;
+    long double sum = 1;
+    for ( int n = 1; n <= TAYLOR_TERMS; n++ )
+    {
+        term *= -radians * radians / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * Sine of a whole number of degrees, folded down to between 0 and 45 degrees
+ * first so the series converges quickly and the quarter turns come out exact.
+ */
+constexpr long double whole_degree_sin(int degrees)
+{
+    degrees = ((degrees % 360) + 360) % 360;
+    if ( degrees >= 180 )
+    {
+        return -whole_degree_sin(degrees - 180);
+    }
+    if ( degrees > 90 )
+    {
+        degrees = 180 - degrees;
+    }
+    if ( degrees > 45 )
+    {
+        return taylor_cos((90 - degrees) * PI_LONG / 180);
+    }
+    return taylor_sin(degrees * PI_LONG / 180);
+}
+
+constexpr trig_table make_trig_table()
+{
+    trig_table table = {};
+
+    for ( int i = 0; i < TRIG_TABLE_SIZE; i++ )
+    {
+        int degrees = TRIG_MIN_DEGREES + i;
+        long double s = whole_degree_sin(degrees);
+        long double c = whole_degree_sin(degrees + 90);
+
+        table.sin[i] = double(s);
+        table.cos[i] = double(c);
+        if ( c == 0 )
+        {
+            table.tan[i] = ( s > 0 ) ? numeric_limits<double>::infinity() : -numeric_limits<double>::infinity();
+            table.sec2[i] = numeric_limits<double>::infinity();
+        }
+        else
+        {
+            table.tan[i] = double(s / c);
+            table.sec2[i] = double(1 / (c * c));
+        }
+    }
+
+    return table;
+}
+
+// filled in by the compiler, so looking an angle up is the only work left
+static constexpr trig_table TRIG = make_trig_table();
+
+double cos_deg(int degrees)
+{
+    return TRIG.cos[trig_index(degrees)];
+}
+
+double sin_deg(int degrees)
+{
+    return TRIG.sin[trig_index(degrees)];
+}
+
+double tan_deg(int degrees)
+{
+    return TRIG.tan[trig_index(degrees)];
+}
+
+double sec2_deg(int degrees)
+{
+    return TRIG.sec2[trig_index(degrees)];
+}
+
+world_point point_along(const world_point &from, const world_point &to, double fraction)
+{
+    if ( fraction >= 1 )
+    {
+        return to;
+    }
+
+    world_point p;
+    p.x = from.x + fraction * (to.x - from.x);
+    p.y = from.y + fraction * (to.y - from.y);
+
+    return p;
+}
+
+double point_distance(const world_point &p1, const world_point &p2)
+{
+    return sqrt((p1.x - p2.x) * (p1.x - p2.x) + (p1.y - p2.y) * (p1.y - p2.y));
+}
+
+/**
+ * where an angle lives in the trig table, wrapping it around if it is
+ * outside the range the table covers
+ */
+int trig_index(int degrees)
+{
+    if ( degrees < TRIG_MIN_DEGREES or degrees > TRIG_MAX_DEGREES )
+    {
+        degrees = ((degrees % 360) + 360) % 360;
+    }
+    return degrees - TRIG_MIN_DEGREES;
+}
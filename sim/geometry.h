@@ -0,0 +1,67 @@
+#ifndef GEOMETRY_H_
+#define GEOMETRY_H_
+
+#include "sim.h"
+
+// contact tests along a segment give the fraction of the way along it the
+// first contact is, or NO_CONTACT if there isn't one
+#define NO_CONTACT 2.0
+
+/**
+ * Cosine of an angle given in whole degrees, looked up in a table the
+ * compiler fills in. Every angle in the simulation is a whole number of
+ * degrees, so nothing needs working out at run time.
+ *
+ * @param    the angle in degrees
+ * @returns  the cosine
+ */
+double cos_deg(int degrees);
+
+/**
+ * Sine of an angle given in whole degrees, looked up like cos_deg.
+ *
+ * @param    the angle in degrees
+ * @returns  the sine
+ */
+double sin_deg(int degrees);
+
+/**
+ * Tangent of an angle given in whole degrees, looked up like cos_deg. It is
+ * infinite where the cosine is zero.
+ *
+ * @param    the angle in degrees
+ * @returns  the tangent
+ */
+double tan_deg(int degrees);
+
+/**
+ * The secant squared (one over the cosine squared) of an angle given in
+ * whole degrees, looked up like cos_deg. It is infinite where the cosine is
+ * zero.
+ *
+ * @param    the angle in degrees
+ * @returns  the secant squared
+ */
+double sec2_deg(int degrees);
+
+/**
+ * The point a fraction of the way along the segment between two points. The
+ * ends of the segment come back exactly.
+ *
+ * @param    where the segment starts
+ * @param    where the segment ends
+ * @param    how far along, from 0 to 1
+ * @returns  the point that far along
+ */
+world_point point_along(const world_point &from, const world_point &to, double fraction);
+
+/**
+ * The straight line distance between two points.
+ *
+ * @param    the first point
+ * @param    the second point
+ * @returns  the distance between them
+ */
+double point_distance(const world_point &p1, const world_point &p2);
+
+#endif
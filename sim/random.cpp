@@ -0,0 +1,53 @@
+#include "random.h"
+
+// constants
+#define GOLDEN_GAMMA 0x9e3779b97f4a7c15ULL
+
+// forward declarations
+uint64_t mix(uint64_t z);
+uint64_t next_random(random_stream &r);
+
+random_stream new_random_stream(uint64_t seed, uint64_t stream_id)
+{
+    random_stream r;
+
+    r.key = mix(mix(seed) ^ (stream_id * GOLDEN_GAMMA));
+    r.counter = 0;
+
+    return r;
+}
+
+/**
+ * The splitmix64 finalizer; scrambles a 64 bit value so that consecutive
+ * inputs give unrelated outputs.
+ */
+uint64_t mix(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Counter based: the n-th value of a stream is just a hash of its key and n,
+ * so there is no hidden state to share between streams or threads.
+ */
+uint64_t next_random(random_stream &r)
+{
+    r.counter++;
+    return mix(r.key + r.counter * GOLDEN_GAMMA);
+}
+
+int random_int(random_stream &r, int ubound)
+{
+    if ( ubound <= 0 ) return 0;
+
+    // scale the top 32 bits into range rather than using a biased modulo
+    return int(((next_random(r) >> 32) * uint64_t(ubound)) >> 32);
+}
+
+double random_double(random_stream &r)
+{
+    // 53 random bits fill a double's mantissa exactly
+    return (next_random(r) >> 11) * (1.0 / 9007199254740992.0);
+}
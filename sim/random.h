@@ -0,0 +1,43 @@
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include "sim.h"
+
+// stream ids; each ai tank gets AI_STREAM + its id, and front ends throw
+// particles about with PARTICLE_STREAM and name ai tanks with NAME_STREAM
+#define TERRAIN_STREAM 1
+#define WIND_STREAM 2
+#define SPAWN_STREAM 3
+#define PARTICLE_STREAM 4
+#define NAME_STREAM 5
+#define AI_STREAM 16
+
+/**
+ * Create a random stream for a seed. Streams with the same seed and a
+ * different id are independent of each other, and the same seed and id always
+ * produce the same sequence.
+ *
+ * @param    the match seed
+ * @param    the id of the stream within the match
+ * @returns  the new stream
+ */
+random_stream new_random_stream(uint64_t seed, uint64_t stream_id);
+
+/**
+ * A random integer from 0 up to, but not including, the upper bound.
+ *
+ * @param    the stream to draw from
+ * @param    the exclusive upper bound
+ * @returns  the random integer
+ */
+int random_int(random_stream &r, int ubound);
+
+/**
+ * A random double between 0 and 1.
+ *
+ * @param    the stream to draw from
+ * @returns  the random double
+ */
+double random_double(random_stream &r);
+
+#endif
@@ -0,0 +1,155 @@
+#include "shot.h"
+#include "tank.h"
+#include "terrain.h"
+#include "geometry.h"
+#include "shot_batch.h"
+#include "firing_table.h"
+#include "world.h"
+
+#include <algorithm> // sort
+#include <cmath>     // pow
+
+// forward declarations
+void move_shot_along_trajectory(shot &s);
+void move_shot_vertically(shot &s);
+void damage_tanks(world &w, const world_point coords, int impact_radius);
+shot shot_from(const tank &t, const world_point &turret_end, int angle, int power);
+
+shot new_shot(const tank &t)
+{
+    return shot_from(t, t.turret_end, t.turret_angle, t.power);
+}
+
+shot new_aimed_shot(const tank &t, int angle, int power)
+{
+    return shot_from(t, turret_end_point(t, angle), angle, power);
+}
+
+/**
+ * a shot leaving the end of a tank's turret
+ */
+shot shot_from(const tank &t, const world_point &turret_end, int angle, int power)
+{
+    shot s;
+
+    s.initial_x = turret_end.x;
+    s.initial_y = turret_end.y;
+    s.owner_id = t.id;
+    s.initial_angle = angle;
+    s.power = power;
+    s.distance = s.initial_x;
+    s.coords.x = s.initial_x;
+    s.coords.y = s.initial_y;
+    s.previous = s.coords;
+
+    return s;
+}
+
+void move_shot(shot &s, const double wind)
+{
+    s.previous = s.coords;
+
+    if ( s.initial_angle != 90 )
+    {
+        move_shot_along_trajectory(s);
+    }
+    else
+    {
+        move_shot_vertically(s);
+    }
+    s.coords.x += wind;
+}
+
+/**
+ * Trajectory of a projectile (with y axis inverted to draw):
+ * https://en.wikipedia.org/wiki/Trajectory_of_a_projectile
+ */
+void move_shot_along_trajectory(shot &s)
+{
+    // move x based on a shot speed adjusted for angle and recalculate y
+    s.distance += cos_deg(s.initial_angle) * SHOT_SPEED;
+    s.coords.x += cos_deg(s.initial_angle) * SHOT_SPEED;
+
+    int theta = s.initial_angle;
+    double g = GRAVITATIONAL_ACCELERATION;
+    double v = s.power;
+    double y0 = s.initial_y;
+    double d = s.distance - s.initial_x;
+
+    // note that we increase height by subtracting y and visa versa
+    s.coords.y = y0 - d * tan_deg(theta) + (g * d * d) * (sec2_deg(theta) / (2 * v * v));
+}
+
+/**
+ * If the angle is straight up, we calculate raw velocity and subtract
+ * shot speed as the acceleration factor.
+ */
+void move_shot_vertically(shot &s)
+{
+    double previous_velocity = s.power;
+    s.power -= 2 * SHOT_SPEED / GRAVITATIONAL_ACCELERATION;
+    s.coords.y += (pow(s.power, 2) - pow(previous_velocity, 2)) / (2 * GRAVITATIONAL_ACCELERATION);
+}
+
+world_point trace_shot(const world &w, shot s, bool &exploded)
+{
+    shot_batch b = new_shot_batch();
+
+    add_to_shot_batch(b, s);
+    trace_shot_batch(w, b, w.wind_strength);
+    exploded = b.exploded[0];
+
+    return b.landed[0];
+}
+
+void explode(world &w, const shot &s, int impact_radius)
+{
+    world_event e;
+    e.kind = SHOT_EXPLODED;
+    e.tank_id = s.owner_id;
+    e.coords = s.coords;
+    e.radius = impact_radius;
+    e.first_column = 0;
+    e.last_column = 0;
+    w.events.push_back(e);
+
+    carve_terrain(w, s.coords, impact_radius, s.owner_id);
+    damage_tanks(w, s.coords, impact_radius);
+}
+
+void carve_terrain(world &w, const world_point coords, int radius, int owner_id)
+{
+    world_event e;
+    e.kind = TERRAIN_CHANGED;
+    e.tank_id = owner_id;
+    e.coords = coords;
+    e.radius = radius;
+
+    destroy_terrain(w.game_terrain, coords, radius, e.first_column, e.last_column);
+    if ( e.first_column <= e.last_column )
+    {
+        w.events.push_back(e);
+
+        // a shot stopped by the ground right on a column edge lands in the
+        // column next to the one it hit
+        invalidate_landings(w, e.first_column - 1, e.last_column + 1);
+        wake_tanks(w, e.first_column, e.last_column);
+    }
+}
+
+/**
+ * Damage tanks as required based on the location of the explosion. Only the
+ * tanks near enough to be reached are looked at, in the order they were added
+ * so events come out the same way every time.
+ */
+void damage_tanks(world &w, const world_point coords, int impact_radius)
+{
+    vector<int> &near = w.nearby;
+
+    tanks_near(w, coords.x - impact_radius, coords.x + impact_radius, near);
+    sort(near.begin(), near.end());
+    for ( int i = 0; i < near.size(); i++ )
+    {
+        damage_tank(w, w.tanks[near[i]], coords, impact_radius);
+    }
+}
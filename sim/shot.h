@@ -0,0 +1,73 @@
+#ifndef SHOT_H_
+#define SHOT_H_ 
+
+#include "sim.h"
+
+// constants
+#define EXPLOSION_MAX_RADIUS 15
+#define GRAVITATIONAL_ACCELERATION 9.81
+#define SHOT_SPEED 4.0
+
+/**
+ * Generate and return a new shot, shot by a given tank, based on it's attrs.
+ *
+ * @param    the tank doing the shooting.
+ * @returns  the new shot
+ */
+shot new_shot(const tank &t);
+
+/**
+ * Generate and return the shot a tank would fire at some other angle and
+ * power, without turning its turret.
+ *
+ * @param    the tank doing the shooting
+ * @param    the turret angle to shoot at
+ * @param    the power to shoot with
+ * @returns  the new shot
+ */
+shot new_aimed_shot(const tank &t, int angle, int power);
+
+/**
+ * Move the shot to the next set of coordinates in it's trajectory, keeping
+ * where it was as the previous coordinates.
+ *
+ * @param    the shot to move
+ * @param    the strength of the wind; negative is left and positive is right
+ */
+void move_shot(shot &s, double wind);
+
+/**
+ * Follow a shot through the world until it explodes or leaves it, exactly as
+ * the world would tick it but with the wind held steady. To follow many shots
+ * at once, use a shot batch. Neither the shot
+ * passed in nor the world are changed.
+ *
+ * @param    the world the shot is in
+ * @param    the shot to follow
+ * @param    set to whether the shot exploded, rather than leaving the world
+ * @returns  where the shot ended up
+ */
+world_point trace_shot(const world &w, shot s, bool &exploded);
+
+/**
+ * A shot has hit the ground, and an explosion should occur. The terrain in
+ * the radius of the shot will be damaged and any tanks hit will be destroyed.
+ *
+ * @param    the world the shot is in
+ * @param    the shot to explode
+ * @param    the radius of the blast
+ */
+void explode(world &w, const shot &s, int impact_radius);
+
+/**
+ * Clear the terrain in a circle without any blast, as a digger does, letting
+ * the front end, firing tables and tanks nearby know the ground changed.
+ *
+ * @param    the world to carve
+ * @param    the center of the circle
+ * @param    the radius of the circle
+ * @param    the id of the tank whose shot did it
+ */
+void carve_terrain(world &w, const world_point coords, int radius, int owner_id);
+
+#endif
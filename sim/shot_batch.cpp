@@ -0,0 +1,313 @@
+#include "shot_batch.h"
+#include "shot.h"
+#include "tank.h"
+#include "geometry.h"
+#include "world.h"
+#include "terrain.h"
+
+#include <algorithm> // max, min, swap
+#include <cmath>     // ceil, fabs
+
+// constants
+#define MAX_TRACE_STEPS 20000
+
+// forward declarations
+void find_reach(const world &w, shot_batch &b, double wind);
+void step_lanes(const world &w, shot_batch &b, double wind);
+void near_lanes(int n, int last_column, const int *__restrict reach, const double *__restrict x,
+                const double *__restrict y, const double *__restrict previous_y, int *__restrict near);
+void sweep_lanes(const world &w, shot_batch &b);
+void land_shots(shot_batch &b, int width);
+void move_shot_batch(shot_batch &b, double wind);
+void move_lanes(int n, double wind, double *__restrict x, double *__restrict y,
+                double *__restrict previous_x, double *__restrict previous_y,
+                double *__restrict distance, double *__restrict power,
+                const double *__restrict initial_x, const double *__restrict initial_y,
+                const double *__restrict step_x, const double *__restrict rise,
+                const double *__restrict drop, const double *__restrict power_decay,
+                const double *__restrict vertical);
+void swap_lanes(shot_batch &b, int i, int j);
+
+shot_batch new_shot_batch()
+{
+    shot_batch b;
+
+    clear_shot_batch(b);
+
+    return b;
+}
+
+void clear_shot_batch(shot_batch &b)
+{
+    b.count = 0;
+    b.flying = 0;
+    b.lane_shot.clear();
+    b.x.clear();
+    b.y.clear();
+    b.previous_x.clear();
+    b.previous_y.clear();
+    b.distance.clear();
+    b.power.clear();
+    b.initial_x.clear();
+    b.initial_y.clear();
+    b.step_x.clear();
+    b.rise.clear();
+    b.drop.clear();
+    b.power_decay.clear();
+    b.vertical.clear();
+    b.hit.clear();
+    b.landed.clear();
+    b.exploded.clear();
+}
+
+/**
+ * The terms of move_shot that only depend on the angle and power are worked
+ * out here, once, in the same order move_shot uses so results match it.
+ */
+int add_to_shot_batch(shot_batch &b, const shot &s)
+{
+    bool vertical = s.initial_angle == 90;
+
+    // lanes past the flying ones belong to landed shots, so keep the new one
+    // with the others in flight
+    int lane = b.x.size();
+    b.lane_shot.push_back(b.count);
+    b.x.push_back(s.coords.x);
+    b.y.push_back(s.coords.y);
+    b.previous_x.push_back(s.previous.x);
+    b.previous_y.push_back(s.previous.y);
+    b.distance.push_back(s.distance);
+    b.power.push_back(s.power);
+    b.initial_x.push_back(s.initial_x);
+    b.initial_y.push_back(s.initial_y);
+    b.step_x.push_back(vertical ? 0 : cos_deg(s.initial_angle) * SHOT_SPEED);
+    b.rise.push_back(vertical ? 0 : tan_deg(s.initial_angle));
+    b.drop.push_back(vertical ? 0 : sec2_deg(s.initial_angle) / (2 * s.power * s.power));
+    b.power_decay.push_back(vertical ? 2 * SHOT_SPEED / GRAVITATIONAL_ACCELERATION : 0);
+    b.vertical.push_back(vertical ? 1 : 0);
+    b.hit.push_back(0);
+    b.landed.push_back(s.coords);
+    b.exploded.push_back(0);
+    swap_lanes(b, b.flying, lane);
+
+    b.flying++;
+    return b.count++;
+}
+
+void step_shot_batch(const world &w, shot_batch &b, double wind)
+{
+    find_reach(w, b, wind);
+    step_lanes(w, b, wind);
+}
+
+void trace_shot_batch(const world &w, shot_batch &b, double wind)
+{
+    // nothing in the world changes while the batch flies, so neither does
+    // how high it can be reached
+    find_reach(w, b, wind);
+
+    for ( int i = 0; i < MAX_TRACE_STEPS and b.flying > 0; i++ )
+    {
+        step_lanes(w, b, wind);
+    }
+}
+
+/**
+ * A step moves a shot at most SHOT_SPEED plus the wind across, so a shot in a
+ * column can only touch ground, a tank or the base of the world that is
+ * within that many columns of it. The highest of those, over every column,
+ * is the ground's top, then every tank's top stamped over a span wide enough
+ * for any lean, then the lot widened by a step each way: first to the right
+ * and then to the left, each in place.
+ */
+void find_reach(const world &w, shot_batch &b, double wind)
+{
+    const terrain &ground = w.game_terrain;
+    int step = int(ceil(SHOT_SPEED + fabs(wind))) + 1;
+
+    b.reach.resize(ground.width);
+    for ( int c = 0; c < ground.width; c++ )
+    {
+        b.reach[c] = min(ground.tops[c], WORLD_HEIGHT - 2);
+    }
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        const tank &t = w.tanks[i];
+        int top = int(floor(t.coords.y)) - 2 * TANK_RADIUS;
+        int first = max(0, int(floor(t.coords.x)) - 2 * TANK_RADIUS);
+        int last = min(ground.width - 1, int(ceil(t.coords.x)) + 4 * TANK_RADIUS);
+        for ( int c = first; c <= last; c++ )
+        {
+            b.reach[c] = min(b.reach[c], top);
+        }
+    }
+
+    for ( int c = 0; c < ground.width; c++ )
+    {
+        for ( int d = c + 1; d <= min(c + step, ground.width - 1); d++ )
+        {
+            b.reach[c] = min(b.reach[c], b.reach[d]);
+        }
+    }
+    for ( int c = ground.width - 1; c >= 0; c-- )
+    {
+        for ( int d = max(c - step, 0); d < c; d++ )
+        {
+            b.reach[c] = min(b.reach[c], b.reach[d]);
+        }
+    }
+}
+
+/**
+ * one step of the batch, once the reach is known
+ */
+void step_lanes(const world &w, shot_batch &b, double wind)
+{
+    sweep_lanes(w, b);
+    land_shots(b, w.game_terrain.width);
+    move_shot_batch(b, wind);
+}
+
+/**
+ * shot_hits along every lane's last step, pulling the lanes that hit something
+ * back to where they first touched. Every lane is tested against the reach
+ * first, in one loop, and only the lanes low enough to touch something are
+ * traced one at a time, which is few of them.
+ */
+void sweep_lanes(const world &w, shot_batch &b)
+{
+    near_lanes(b.flying, w.game_terrain.width - 1, b.reach.data(), b.x.data(), b.y.data(),
+               b.previous_y.data(), b.hit.data());
+
+    for ( int i = 0; i < b.flying; i++ )
+    {
+        if ( not b.hit[i] ) continue;
+
+        world_point from, to, contact;
+        from.x = b.previous_x[i];
+        from.y = b.previous_y[i];
+        to.x = b.x[i];
+        to.y = b.y[i];
+
+        b.hit[i] = shot_hits(w, from, to, contact);
+        if ( b.hit[i] )
+        {
+            b.x[i] = contact.x;
+            b.y[i] = contact.y;
+        }
+    }
+}
+
+/**
+ * The reach test kernel: a lane is near something if either end of its last
+ * step is as low as the reach of the column it is in. Lanes off the side of
+ * the world use the edge column's reach.
+ */
+void near_lanes(int n, int last_column, const int *__restrict reach, const double *__restrict x,
+                const double *__restrict y, const double *__restrict previous_y, int *__restrict near)
+{
+    for ( int i = 0; i < n; i++ )
+    {
+        int c = min(max(int(x[i]), 0), last_column);
+        near[i] = max(previous_y[i], y[i]) >= reach[c];
+    }
+}
+
+/**
+ * record shots that hit something or left the world and swap their lanes out
+ * of the flying range
+ */
+void land_shots(shot_batch &b, int width)
+{
+    int i = 0;
+    while ( i < b.flying )
+    {
+        bool off_world = b.x[i] >= width or b.x[i] <= 0;
+        if ( b.hit[i] or off_world )
+        {
+            int s = b.lane_shot[i];
+            b.landed[s].x = b.x[i];
+            b.landed[s].y = b.y[i];
+            b.exploded[s] = b.hit[i];
+            b.flying--;
+            swap_lanes(b, i, b.flying);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/**
+ * move_shot for every lane
+ */
+void move_shot_batch(shot_batch &b, double wind)
+{
+    move_lanes(b.flying, wind, b.x.data(), b.y.data(), b.previous_x.data(), b.previous_y.data(),
+               b.distance.data(), b.power.data(), b.initial_x.data(), b.initial_y.data(),
+               b.step_x.data(), b.rise.data(), b.drop.data(), b.power_decay.data(),
+               b.vertical.data());
+}
+
+/**
+ * The moving kernel itself. Both the angled and the vertical update are
+ * worked out for every lane and blended by the vertical flag, which is 0 or
+ * 1, so there is no branch to stop the loop vectorizing. The update a lane
+ * doesn't use always comes out finite (the angled one stays at the starting
+ * height for vertical lanes and the vertical one adds 0 for angled lanes), so
+ * the blend is exact. The
+ * lanes come in as restrict parameters so the compiler knows they never
+ * overlap.
+ */
+void move_lanes(int n, double wind, double *__restrict x, double *__restrict y,
+                double *__restrict previous_x, double *__restrict previous_y,
+                double *__restrict distance, double *__restrict power,
+                const double *__restrict initial_x, const double *__restrict initial_y,
+                const double *__restrict step_x, const double *__restrict rise,
+                const double *__restrict drop, const double *__restrict power_decay,
+                const double *__restrict vertical)
+{
+    for ( int i = 0; i < n; i++ )
+    {
+        previous_x[i] = x[i];
+        previous_y[i] = y[i];
+        distance[i] += step_x[i];
+        x[i] += step_x[i];
+        x[i] += wind;
+
+        double d = distance[i] - initial_x[i];
+        double angled_y = initial_y[i] - d * rise[i] + (GRAVITATIONAL_ACCELERATION * d * d) * drop[i];
+
+        double previous_power = power[i];
+        power[i] -= power_decay[i];
+        double vertical_y = y[i] + (power[i] * power[i] - previous_power * previous_power) /
+                                   (2 * GRAVITATIONAL_ACCELERATION);
+
+        y[i] = angled_y * (1 - vertical[i]) + vertical_y * vertical[i];
+    }
+}
+
+/**
+ * swap everything about two lanes
+ */
+void swap_lanes(shot_batch &b, int i, int j)
+{
+    if ( i == j ) return;
+
+    swap(b.lane_shot[i], b.lane_shot[j]);
+    swap(b.x[i], b.x[j]);
+    swap(b.y[i], b.y[j]);
+    swap(b.previous_x[i], b.previous_x[j]);
+    swap(b.previous_y[i], b.previous_y[j]);
+    swap(b.distance[i], b.distance[j]);
+    swap(b.power[i], b.power[j]);
+    swap(b.initial_x[i], b.initial_x[j]);
+    swap(b.initial_y[i], b.initial_y[j]);
+    swap(b.step_x[i], b.step_x[j]);
+    swap(b.rise[i], b.rise[j]);
+    swap(b.drop[i], b.drop[j]);
+    swap(b.power_decay[i], b.power_decay[j]);
+    swap(b.vertical[i], b.vertical[j]);
+    swap(b.hit[i], b.hit[j]);
+}
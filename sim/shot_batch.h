@@ -0,0 +1,50 @@
+#ifndef SHOT_BATCH_H_
+#define SHOT_BATCH_H_
+
+#include "sim.h"
+
+/**
+ * Create and return a new, empty shot batch.
+ *
+ * @returns  the new shot batch
+ */
+shot_batch new_shot_batch();
+
+/**
+ * Empty a shot batch so it can be reused without reallocating.
+ *
+ * @param    the shot batch to empty
+ */
+void clear_shot_batch(shot_batch &b);
+
+/**
+ * Add a shot to a batch.
+ *
+ * @param    the batch to add to
+ * @param    the shot to add
+ * @returns  the index the shot's result will be recorded at
+ */
+int add_to_shot_batch(shot_batch &b, const shot &s);
+
+/**
+ * Advance every shot in flight by one world tick, exactly as shot_tick would:
+ * shots that have hit something explode, shots off the side of the world
+ * miss, and the rest move.
+ *
+ * @param    the world the shots are in
+ * @param    the batch to advance
+ * @param    the strength of the wind to move the shots in
+ */
+void step_shot_batch(const world &w, shot_batch &b, double wind);
+
+/**
+ * Step a batch until every shot in it has exploded or missed, with the wind
+ * held steady.
+ *
+ * @param    the world the shots are in
+ * @param    the batch to trace
+ * @param    the strength of the wind to move the shots in
+ */
+void trace_shot_batch(const world &w, shot_batch &b, double wind);
+
+#endif
@@ -0,0 +1,168 @@
+#include "shot_search.h"
+#include "tank.h"
+#include "shot.h"
+#include "firing_table.h"
+#include "geometry.h"
+
+#include <algorithm> // max, min
+
+// constants
+#define SEARCH_COARSE_STEP 4
+#define SEARCH_REFINED_CELLS 8
+
+/**
+ * A shot the search has traced, and how good it is.
+ */
+struct search_candidate
+{
+    int entry;
+    double score;
+    double distance;
+};
+
+// forward declarations
+void score_candidates(const world &w, const tank &shooter, const world_point &aim_point,
+                      const firing_table &table, search_candidate best[], int &kept);
+bool better_candidate(const search_candidate &a, const search_candidate &b);
+void want_coarse_grid(const tank &shooter, int min_angle, int max_angle, vector<int> &wanted);
+void want_around(const tank &shooter, const firing_entry &e, int min_angle, int max_angle,
+                 vector<int> &wanted);
+double shot_score(const world &w, const tank &shooter, const world_point &impact);
+
+/**
+ * Coarse to fine: a grid every SEARCH_COARSE_STEP degrees and units of power
+ * is traced first, then every shot in the cells around the best few coarse
+ * shots. Damage and closeness to the target both change smoothly between
+ * neighbouring shots, so the best shot is almost always next to one of the
+ * best coarse ones, and only a fraction of the table is ever traced.
+ */
+void search_shot(const world &w, const tank &shooter, const tank &target, firing_table &table,
+                 int &angle, int &power)
+{
+    world_point aim_point = tank_center(target);
+    search_candidate best[SEARCH_REFINED_CELLS];
+    int kept = 0;
+
+    // the same limits bound_targets keeps the classic brain inside
+    int min_angle = TANK_MIN_ANGLE + shooter.base_angle + 2;
+    int max_angle = TANK_MAX_ANGLE - shooter.base_angle - 2;
+
+    angle = max(min_angle, min(shooter.turret_angle, max_angle));
+    power = shooter.power;
+
+    want_coarse_grid(shooter, min_angle, max_angle, table.wanted);
+    refresh_firing_table(w, shooter, table, table.wanted);
+    score_candidates(w, shooter, aim_point, table, best, kept);
+
+    table.wanted.clear();
+    for ( int i = 0; i < kept; i++ )
+    {
+        want_around(shooter, table.entries[best[i].entry], min_angle, max_angle, table.wanted);
+    }
+    refresh_firing_table(w, shooter, table, table.wanted);
+    score_candidates(w, shooter, aim_point, table, best, kept);
+
+    if ( kept > 0 )
+    {
+        angle = table.entries[best[0].entry].angle;
+        power = table.entries[best[0].entry].power;
+    }
+}
+
+/**
+ * Score every wanted shot that explodes and keep the best, best first. A
+ * shot wanted more than once is only kept once.
+ */
+void score_candidates(const world &w, const tank &shooter, const world_point &aim_point,
+                      const firing_table &table, search_candidate best[], int &kept)
+{
+    for ( int i = 0; i < table.wanted.size(); i++ )
+    {
+        const firing_entry &e = table.entries[table.wanted[i]];
+        if ( not e.exploded ) continue;
+
+        search_candidate c;
+        c.entry = table.wanted[i];
+        c.score = shot_score(w, shooter, e.landed);
+        c.distance = point_distance(e.landed, aim_point);
+
+        bool repeat = false;
+        for ( int j = 0; j < kept; j++ )
+        {
+            repeat = repeat or best[j].entry == c.entry;
+        }
+        if ( repeat or (kept == SEARCH_REFINED_CELLS and not better_candidate(c, best[kept - 1])) )
+        {
+            continue;
+        }
+
+        // insert it in order, dropping the worst if there is no room
+        int j = min(kept, SEARCH_REFINED_CELLS - 1);
+        while ( j > 0 and better_candidate(c, best[j - 1]) )
+        {
+            best[j] = best[j - 1];
+            j--;
+        }
+        best[j] = c;
+        kept = min(kept + 1, SEARCH_REFINED_CELLS);
+    }
+}
+
+/**
+ * more damage is better; at the same damage, landing closer to the target is
+ */
+bool better_candidate(const search_candidate &a, const search_candidate &b)
+{
+    return a.score > b.score or (a.score == b.score and a.distance < b.distance);
+}
+
+/**
+ * every SEARCH_COARSE_STEP degrees and units of power the tank can aim at
+ */
+void want_coarse_grid(const tank &shooter, int min_angle, int max_angle, vector<int> &wanted)
+{
+    wanted.clear();
+    for ( int a = min_angle; a <= max_angle; a += SEARCH_COARSE_STEP )
+    {
+        for ( int p = TANK_MIN_POWER; p <= TANK_MAX_POWER; p += SEARCH_COARSE_STEP )
+        {
+            wanted.push_back(firing_entry_index(shooter, a, p));
+        }
+    }
+}
+
+/**
+ * every shot within a coarse step of a traced one, in the table
+ */
+void want_around(const tank &shooter, const firing_entry &e, int min_angle, int max_angle,
+                 vector<int> &wanted)
+{
+    int first_angle = max(min_angle, e.angle - SEARCH_COARSE_STEP + 1);
+    int last_angle = min(max_angle, e.angle + SEARCH_COARSE_STEP - 1);
+    int first_power = max(TANK_MIN_POWER, e.power - SEARCH_COARSE_STEP + 1);
+    int last_power = min(TANK_MAX_POWER, e.power + SEARCH_COARSE_STEP - 1);
+
+    for ( int a = first_angle; a <= last_angle; a += FIRING_ANGLE_STEP )
+    {
+        for ( int p = first_power; p <= last_power; p += FIRING_POWER_STEP )
+        {
+            wanted.push_back(firing_entry_index(shooter, a, p));
+        }
+    }
+}
+
+/**
+ * damage to everyone else, less double the damage we'd do to ourselves
+ */
+double shot_score(const world &w, const tank &shooter, const world_point &impact)
+{
+    double score = 0;
+
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        int damage = explosion_damage(w.tanks[i], impact, EXPLOSION_MAX_RADIUS);
+        score += ( w.tanks[i].id == shooter.id ) ? -2 * damage : damage;
+    }
+
+    return score;
+}
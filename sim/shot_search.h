@@ -0,0 +1,23 @@
+#ifndef SHOT_SEARCH_H_
+#define SHOT_SEARCH_H_
+
+#include "sim.h"
+
+/**
+ * Find the best shot for a tank at a target by searching the angles and
+ * powers in the tank's firing table, coarse to fine, refreshing the entries
+ * it looks at against the real terrain, wind and tanks. A candidate scores
+ * the damage it would do to other tanks less twice what it would do to the
+ * shooter; ties go to whichever lands closest to the target.
+ *
+ * @param    the world the tanks are in
+ * @param    the tank that will shoot
+ * @param    the tank being aimed at
+ * @param    the shooting tank's firing table
+ * @param    set to the best angle found
+ * @param    set to the best power found
+ */
+void search_shot(const world &w, const tank &shooter, const tank &target, firing_table &table,
+                 int &angle, int &power);
+
+#endif
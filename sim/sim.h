@@ -0,0 +1,23 @@
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The simulation core. Nothing in this directory may depend on windowing,
+ * audio or bitmaps; the GUI (and any headless runner) is just a front end
+ * that drives the world with tick and reacts to the events it emits.
+ */
+
+// worlds can be any width, chosen when they are made; this one is a screen
+#define DEFAULT_WORLD_WIDTH 800
+#define WORLD_HEIGHT 600
+
+#include "sim_types.h"
+
+#endif
@@ -0,0 +1,384 @@
+#ifndef SIM_TYPES_H_
+#define SIM_TYPES_H_
+
+// forward declarations
+struct tank;
+
+/**
+ * A point in the world, with y increasing downwards like the screen.
+ */
+struct world_point
+{
+    double x;
+    double y;
+};
+
+/**
+ * A counter based random number stream. Each value is a hash of the key and
+ * the counter, so a stream is just these two numbers.
+ */
+struct random_stream
+{
+    uint64_t key;
+    uint64_t counter;
+};
+
+/**
+ * The current state a brain is in.
+ */
+enum brain_state
+{
+    THINKING,
+    READY,
+    WAITING
+};
+
+/**
+ * The different kinds of brain an ai tank can have. Classic brains learn from
+ * their last shot; naive brains start from a fresh estimate every turn; search
+ * brains simulate a grid of shots and fire the best.
+ */
+enum brain_variant
+{
+    CLASSIC_BRAIN,
+    NAIVE_BRAIN,
+    SEARCH_BRAIN
+};
+
+/**
+ * The kinds of landscape a world can be generated with. Classic terrain is
+ * straight hills and valleys of random length; the rest are built from
+ * layers of seeded noise: rolling hills, flat topped plateaus with steep sides,
+ * and jagged mountains.
+ */
+enum terrain_preset
+{
+    CLASSIC_TERRAIN,
+    ROLLING_HILLS,
+    PLATEAUS,
+    MOUNTAINS
+};
+
+/**
+ * The weapons a tank can fire. A shell is a single round that explodes where
+ * it lands. A MIRV splits into warheads, which are shells, at the top of its
+ * flight; a cluster bomb bursts into bomblets where it lands; a roller rolls
+ * downhill once it lands and goes off at the bottom; a digger tunnels on
+ * through the dirt. Bomblets are never fired, only burst into.
+ */
+enum weapon_kind
+{
+    SHELL,
+    MIRV,
+    CLUSTER_BOMB,
+    ROLLER,
+    DIGGER,
+    BOMBLET
+};
+
+/**
+ * Something happened in the world that a front end may want to show or play.
+ */
+enum world_event_kind
+{
+    SHOT_FIRED,
+    POWER_CHANGED,
+    ANGLE_CHANGED,
+    SHOT_EXPLODED,
+    TERRAIN_CHANGED,
+    TANK_DESTROYED,
+    MATCH_WON,
+    MATCH_DRAWN
+};
+
+/**
+ * A single world event. Not every kind uses every field; the columns are the
+ * range of terrain a TERRAIN_CHANGED event covers.
+ */
+struct world_event
+{
+    world_event_kind kind;
+    int tank_id;
+    world_point coords;
+    int radius;
+    int first_column;
+    int last_column;
+};
+
+/**
+ * A solid run of dirt down one column of terrain, from the top y down to but
+ * not including the bottom y.
+ */
+struct terrain_span
+{
+    int top;
+    int bottom;
+};
+
+/**
+ * A run of neighbouring columns' spans, packed one after another: the
+ * chunk's column x runs from first_span[x] up to first_span[x + 1]. A change
+ * to one column only moves the spans after it in the same chunk.
+ */
+struct terrain_chunk
+{
+    vector<terrain_span> spans;
+    vector<int> first_span;
+};
+
+/**
+ * Terrain represents the landscape on which the tank battle takes place. It is
+ * width columns wide. Each column is a run length list of solid spans from the
+ * top down, so dirt can hang over holes and tunnels. The lists are kept in
+ * chunks of TERRAIN_CHUNK_COLUMNS columns: column x is column
+ * x % TERRAIN_CHUNK_COLUMNS of chunk x / TERRAIN_CHUNK_COLUMNS. Tops is the top of each column's highest span, or
+ * WORLD_HEIGHT if it has none. Below WORLD_HEIGHT is bedrock. Highest is a
+ * segment tree over tops with tree_leaves leaves, the width rounded up to a
+ * power of two: node 1 is the whole world, node n's children are 2n and
+ * 2n + 1, and each node holds the smallest top, which is the highest ground,
+ * under it. Columns whose dirt may still be falling or sliding wait in
+ * settling, and are flagged in unsettled so none is listed twice; a tick of
+ * settling swaps them into settling now to work through. Carved
+ * spans and carved first span are where destroy_terrain builds the columns it
+ * is about to splice in, kept between blasts so carving reuses them.
+ */
+struct terrain
+{
+    int width;
+    vector<terrain_chunk> chunks;
+    vector<int> tops;
+    int tree_leaves;
+    vector<int> highest;
+    vector<int> settling;
+    vector<int> settling_now;
+    vector<bool> unsettled;
+    vector<terrain_span> carved_spans;
+    vector<int> carved_first_span;
+};
+
+/**
+ * Shot is a shot fired from a tank. It remembers where it was a step ago, so
+ * it can hit anything between there and where it is now.
+ */
+struct shot
+{
+    double initial_y;
+    double initial_x;
+    int owner_id;
+    int initial_angle;
+    double power;
+    double distance;
+    world_point coords;
+    world_point previous;
+};
+
+/**
+ * One projectile in the air, or on the ground for weapons that roll or dig
+ * once they land, heading along the ground or through it until the fuse runs
+ * out. The lead projectile is the one its tank follows: the round it fired,
+ * or the part of it that carries on once that splits.
+ */
+struct projectile
+{
+    weapon_kind weapon;
+    shot flight;
+    bool lead;
+    bool grounded;
+    bool spent;
+    world_point heading;
+    int fuse;
+};
+
+/**
+ * Where one candidate shot in a firing table ends up, and the columns it
+ * flies across on the way. Stale entries need tracing again. Trace counts how
+ * many times it has been traced.
+ */
+struct firing_entry
+{
+    int angle;
+    int power;
+    world_point landed;
+    bool exploded;
+    bool stale;
+    int left;
+    int right;
+    int trace;
+};
+
+/**
+ * An entry filed in one of a firing table's buckets, as of one trace of it.
+ * Once the entry is traced again the filing is out of date and is dropped the
+ * next time the bucket is looked through.
+ */
+struct firing_filing
+{
+    int entry;
+    int trace;
+};
+
+/**
+ * Many shots stepped together. Each attribute is its own array (one lane per
+ * shot in flight) so a step is a handful of straight loops the compiler can
+ * vectorize. Lanes still in flight are always packed at the front; when a
+ * shot lands its lane is swapped out, and where it ended up is recorded
+ * against the index add_to_shot_batch gave it. Reach is, for each column,
+ * the highest a shot there can be and still touch anything within one step,
+ * worked out once for each trace.
+ */
+struct shot_batch
+{
+    int count;
+    int flying;
+    vector<int> lane_shot;
+    vector<double> x;
+    vector<double> y;
+    vector<double> previous_x;
+    vector<double> previous_y;
+    vector<double> distance;
+    vector<double> power;
+    vector<double> initial_x;
+    vector<double> initial_y;
+    vector<double> step_x;
+    vector<double> rise;
+    vector<double> drop;
+    vector<double> power_decay;
+    vector<double> vertical;
+    vector<int> hit;
+    vector<world_point> landed;
+    vector<unsigned char> exploded;
+    vector<int> reach;
+};
+
+/**
+ * A firing table caches where every shot a tank could fire would land, for
+ * the tank where it is now and one bucket of wind. The revision counts how
+ * many times terrain or tanks have changed under it. Entries are filed in
+ * buckets of FIRING_BUCKET_COLUMNS columns: landings by the column each
+ * exploded entry landed in, and crossings by every column it flew across,
+ * so a change to some columns only looks at the entries filed there. The
+ * batch, the entries traced in it and the entries a search wants are kept
+ * between refreshes so tracing reuses them.
+ */
+struct firing_table
+{
+    world_point shooter_coords;
+    int base_angle;
+    int wind_bucket;
+    int revision;
+    vector<firing_entry> entries;
+    vector<vector<firing_filing>> landings;
+    vector<vector<firing_filing>> crossings;
+    shot_batch batch;
+    vector<int> traced;
+    vector<int> wanted;
+};
+
+/**
+ * What a brain decided to do about its turn: who to aim at and how. The
+ * brain's random stream comes back too, since deciding may have drawn from it,
+ * and so does its firing table, since deciding may have refreshed it.
+ */
+struct brain_decision
+{
+    int target_id;
+    int target_angle;
+    int target_power;
+    random_stream random;
+    firing_table table;
+};
+
+/**
+ * Brain, makes smart. The aim speed is how many turret units per second
+ * the brain moves while lining up a shot, or INSTANT_AIM to snap straight
+ * there. Brains that think in the background keep their unfinished
+ * decision as pending until it is ready. Search brains keep a firing table
+ * between turns.
+ */
+struct brain
+{
+    brain_state state;
+    brain_variant variant;
+    random_stream random;
+    double aim_speed;
+    double aim_budget;
+    bool think_async;
+    shared_future<brain_decision> pending;
+    firing_table table;
+    tank *target;
+    shot *last_shot;
+    int target_angle;
+    int target_power;
+};
+
+/**
+ * Where a tank sits: the top of its box and how far its base leans.
+ */
+struct tank_pose
+{
+    double y;
+    int base_angle;
+};
+
+/**
+ * Tanks. Enough said.
+ */
+struct tank
+{
+    int id;
+    string name;
+    bool is_ai;
+    brain ai;
+    int health;
+    bool alive;
+    world_point coords;
+    int turret_angle;
+    world_point turret_end;
+    int power;
+    weapon_kind weapon;
+    int base_angle;
+    bool asleep;
+    bool shooting;
+    shot active_shot;
+};
+
+/**
+ * The world holds all simulation state for a match. Events accumulate as the
+ * world ticks and are drained by whichever front end is driving it. All
+ * randomness comes from the world's own streams, so a seed replays a match.
+ * Tank cells are a broad phase over the tanks: the world is cut into
+ * TANK_CELL_WIDTH wide cells, each listing the index of every tank whose hull
+ * reaches into it. Falling tanks drop fall_speed pixels a tick, or snap straight
+ * to rest if it is INSTANT_FALL. Tanks at rest sleep until the ground under
+ * them changes; the rest are listed in awake_tanks, and only they fall. Every
+ * projectile in the air shares one pool, reserved for MAX_PROJECTILES up front
+ * so firing never allocates. Nearby is where explosions list the tanks they
+ * might reach, and settled is where a tick of settling lists the columns it
+ * changed, both kept from one use to the next for the same reason. Round
+ * counts how many times the turn has come back round to the first tank;
+ * unless max rounds is NO_ROUND_LIMIT, the match ends once that many have
+ * been played.
+ */
+struct world
+{
+    uint64_t seed;
+    random_stream terrain_random;
+    random_stream wind_random;
+    random_stream spawn_random;
+    terrain game_terrain;
+    vector<tank> tanks;
+    vector<vector<int>> tank_cells;
+    double fall_speed;
+    vector<int> awake_tanks;
+    vector<projectile> projectiles;
+    vector<int> nearby;
+    vector<int> settled;
+    tank *active_tank;
+    double wind_strength;
+    int round;
+    int max_rounds;
+    bool over;
+    vector<world_event> events;
+};
+
+#endif
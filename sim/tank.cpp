@@ -0,0 +1,529 @@
+#include "tank.h"
+#include "brain.h"
+#include "terrain.h"
+#include "shot.h"
+#include "geometry.h"
+#include "random.h"
+#include "weapon.h"
+
+#include <algorithm> // max, min
+#include <cmath>     // geometry
+
+// constants
+#define DEGREES_PER_RADIAN (180 / 3.14159265358979323846)
+#define REST_PASSES 4
+
+// forward declarations
+string random_name(random_stream &r);
+int ground_points(const tank &t, const terrain &ground, double reach, world_point *points);
+bool hull_slope(const world_point *points, int count, double &slope);
+double turn(const world_point &o, const world_point &a, const world_point &b);
+double rest_height(const world_point *points, int count, int base_angle);
+world_point left_base_point(const tank &t);
+world_point right_base_point(const tank &t);
+bool tank_hit(const tank &t, const world_point coords, int impact_radius);
+world_point hull_point(const tank &t, const world_point &p);
+bool hull_contains(const world_point &local);
+void destroy_tank(world &w, tank &t);
+void emit_tank_event(world &w, const tank &t, world_event_kind kind);
+
+tank new_tank(int id)
+{
+    tank t;
+
+    t.id = id;
+    t.name = "TANK" + to_string(id);
+    t.is_ai = false;
+    t.ai = new_brain();
+    t.health = 100;
+    t.alive = true;
+    t.coords.x = 0;
+    t.coords.y = 0;
+    t.turret_angle = 90;
+    t.power = 50;
+    t.weapon = SHELL;
+    t.base_angle = 0;
+    t.asleep = false;
+    t.shooting = false;
+
+    return t;
+}
+
+void initialize_tank(tank &t, random_stream &r, int world_width)
+{
+    t.coords.x = 10 + random_int(r, world_width - 2 * TANK_RADIUS - 20);
+    t.coords.y = 0;
+}
+
+void generate_name(tank &t, random_stream &r)
+{
+    t.name = random_name(r);
+}
+
+/**
+ * Returns a random tank name.
+ */
+string random_name(random_stream &r)
+{
+    vector<string> names;
+
+    names.push_back("SKYNET");
+    names.push_back("SMARTANK");
+    names.push_back("DUMBTANK");
+    names.push_back("TANKDUDE");
+    names.push_back("TANKGUY");
+    names.push_back("TANKETTE");
+    names.push_back("TANKGIRL");
+    names.push_back("TANKSTER");
+    names.push_back("FISH");
+    names.push_back("SEPTIC");
+    names.push_back("THOMAS");
+    names.push_back("AIMBOT");
+    names.push_back("PANZER");
+    names.push_back("SHERMAN");
+    names.push_back("ACAIN");
+
+    return names[random_int(r, names.size())];
+}
+
+world_point tank_center(const tank &t)
+{
+    world_point center;
+
+    // half way up the hull, square to the base whichever way it leans
+    world_point mbp = mid_base_point(t);
+    center.x = mbp.x + sin_deg(t.base_angle) * TANK_RADIUS / 2;
+    center.y = mbp.y - cos_deg(t.base_angle) * TANK_RADIUS / 2;
+
+    return center;
+}
+
+world_point turret_end_point(const tank &t, int turret_angle)
+{
+    world_point center = mid_base_point(t);
+    world_point end;
+
+    if ( turret_angle <= 90 )
+    {
+        end.x = cos_deg(turret_angle) * 1.5 * TANK_RADIUS + center.x;
+        end.y = center.y - sin_deg(turret_angle) * 1.5 * TANK_RADIUS;
+    }
+    else
+    {
+        end.x = -cos_deg(180 - turret_angle) * 1.5 * TANK_RADIUS + center.x;
+        end.y = center.y - sin_deg(180 - turret_angle) * 1.5 * TANK_RADIUS;
+    }
+
+    return end;
+}
+
+void set_turret_position(tank &t)
+{
+    t.turret_end = turret_end_point(t, t.turret_angle);
+}
+
+void power_up(world &w, tank &t)
+{
+    emit_tank_event(w, t, POWER_CHANGED);
+    t.power++;
+}
+
+void power_down(world &w, tank &t)
+{
+    emit_tank_event(w, t, POWER_CHANGED);
+    t.power--;
+}
+
+void angle_up(world &w, tank &t)
+{
+    emit_tank_event(w, t, ANGLE_CHANGED);
+    t.turret_angle++;
+}
+
+void angle_down(world &w, tank &t)
+{
+    emit_tank_event(w, t, ANGLE_CHANGED);
+    t.turret_angle--;
+}
+
+void shoot(world &w, tank &t)
+{
+    emit_tank_event(w, t, SHOT_FIRED);
+    set_turret_position(t);
+    t.active_shot = new_shot(t);
+    t.shooting = true;
+    fire_weapon(w, t);
+}
+
+bool fall(tank &t, const terrain &ground, double speed)
+{
+    tank_pose rest = resting_pose(t, ground);
+
+    if ( speed == INSTANT_FALL )
+    {
+        t.coords.y = rest.y;
+        t.base_angle = rest.base_angle;
+    }
+    else if ( t.coords.y != rest.y )
+    {
+        t.coords.y = ( t.coords.y < rest.y ) ? min(t.coords.y + speed, rest.y) : max(t.coords.y - speed, rest.y);
+    }
+    else if ( t.base_angle != rest.base_angle )
+    {
+        t.base_angle += ( t.base_angle < rest.base_angle ) ? 1 : -1;
+    }
+
+    return t.coords.y != rest.y or t.base_angle != rest.base_angle;
+}
+
+bool falling(const tank &t, const terrain &ground)
+{
+    if ( t.asleep )
+    {
+        return false;
+    }
+
+    tank_pose rest = resting_pose(t, ground);
+
+    return t.coords.y != rest.y or t.base_angle != rest.base_angle;
+}
+
+tank_pose resting_pose(const tank &t, const terrain &ground)
+{
+    world_point points[2 * TANK_RADIUS + 2];
+    tank_pose pose;
+    double slope;
+    int count = ground_points(t, ground, TANK_RADIUS, points);
+
+    pose.y = t.coords.y;
+    pose.base_angle = t.base_angle;
+    if ( count == 0 )
+    {
+        return pose;
+    }
+
+    // the base reaches less far across the more it leans, which can leave it
+    // on less ground, so each lean found is looked at again until it holds
+    int reach_angle = 0;
+    for ( int pass = 0; pass < REST_PASSES and hull_slope(points, count, slope); pass++ )
+    {
+        pose.base_angle = int(round(atan(slope) * DEGREES_PER_RADIAN));
+        pose.base_angle = max(-MAX_BASE_ANGLE, min(pose.base_angle, MAX_BASE_ANGLE));
+        if ( pose.base_angle == reach_angle )
+        {
+            break;
+        }
+        reach_angle = pose.base_angle;
+        count = ground_points(t, ground, TANK_RADIUS * cos_deg(reach_angle), points);
+    }
+    pose.y = rest_height(points, count, pose.base_angle) - TANK_RADIUS;
+
+    return pose;
+}
+
+/**
+ * The ground under the base, as points measured across from the middle of the
+ * base, one for the top of each column within reach. Nothing but the tops
+ * goes into the pose, so a tank at rest stays at rest until they change.
+ * Returns how many points there are.
+ */
+int ground_points(const tank &t, const terrain &ground, double reach, world_point *points)
+{
+    double cx = t.coords.x + TANK_RADIUS;
+    int count = 0;
+
+    for ( int column = int(floor(cx - reach)); column <= int(floor(cx + reach)); column++ )
+    {
+        double across = column + 0.5 - cx;
+        if ( abs(across) <= reach and column >= 0 and column < ground.width )
+        {
+            points[count].x = across;
+            points[count].y = ground.tops[column];
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * The slope of the edge of the ground's convex hull that passes under the
+ * middle of the base, or false if there is no ground on one side of it. Y
+ * grows downwards, so the hull seen from above is built like a lower hull.
+ */
+bool hull_slope(const world_point *points, int count, double &slope)
+{
+    world_point hull[2 * TANK_RADIUS + 2];
+    int size = 0;
+
+    for ( int i = 0; i < count; i++ )
+    {
+        while ( size >= 2 and turn(hull[size - 2], hull[size - 1], points[i]) <= 0 )
+        {
+            size--;
+        }
+        hull[size++] = points[i];
+    }
+    for ( int i = 1; i < size; i++ )
+    {
+        if ( hull[i - 1].x < 0 and hull[i].x > 0 )
+        {
+            slope = (hull[i].y - hull[i - 1].y) / (hull[i].x - hull[i - 1].x);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * which way does the path o, a, b turn? Positive one way, negative the other,
+ * zero if it runs straight
+ */
+double turn(const world_point &o, const world_point &a, const world_point &b)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+/**
+ * how low can the middle of the base sit at this lean without any of the
+ * ground poking above it?
+ */
+double rest_height(const world_point *points, int count, int base_angle)
+{
+    double lean = tan_deg(base_angle);
+    double height = WORLD_HEIGHT;
+
+    for ( int i = 0; i < count; i++ )
+    {
+        height = min(height, points[i].y - points[i].x * lean);
+    }
+
+    return height;
+}
+
+/**
+ * The left base point of the tank as visually displayed, including rotation.
+ */
+world_point left_base_point(const tank &t)
+{
+    world_point lbp;
+
+    if ( t.base_angle >= 0 )
+    {
+        lbp.x = t.coords.x + TANK_RADIUS - cos_deg(t.base_angle) * TANK_RADIUS;
+        lbp.y = t.coords.y + TANK_RADIUS - sin_deg(t.base_angle) * TANK_RADIUS;
+    }
+    else
+    {
+        lbp.x = t.coords.x + TANK_RADIUS - cos_deg(-t.base_angle) * TANK_RADIUS;
+        lbp.y = t.coords.y + TANK_RADIUS + sin_deg(-t.base_angle) * TANK_RADIUS;
+    }
+
+    return lbp;
+}
+
+world_point mid_base_point(const tank &t)
+{
+    world_point lbp = left_base_point(t);
+    world_point rbp = right_base_point(t);
+    world_point mbp;
+
+    mbp.x = (lbp.x + rbp.x) / 2;
+    mbp.y = (lbp.y + rbp.y) / 2;
+
+    return mbp;
+}
+
+/**
+ * The right base point of the tank as visually displayed, including rotation.
+ */
+world_point right_base_point(const tank &t)
+{
+    world_point rbp;
+
+    if ( t.base_angle >= 0 )
+    {
+        rbp.x = t.coords.x + TANK_RADIUS + cos_deg(t.base_angle) * TANK_RADIUS;
+        rbp.y = t.coords.y + TANK_RADIUS + sin_deg(t.base_angle) * TANK_RADIUS;
+    }
+    else
+    {
+        rbp.x = t.coords.x + TANK_RADIUS + cos_deg(-t.base_angle) * TANK_RADIUS;
+        rbp.y = t.coords.y + TANK_RADIUS - sin_deg(-t.base_angle) * TANK_RADIUS;
+    }
+
+    return rbp;
+}
+
+void damage_tank(world &w, tank &t, const world_point coords, int impact_radius)
+{
+    if ( tank_hit(t, coords, impact_radius) and t.alive )
+    {
+        t.health -= explosion_damage(t, coords, impact_radius);
+        if ( t.health <= 0 )
+        {
+            destroy_tank(w, t);
+        }
+    }
+}
+
+int explosion_damage(const tank &t, const world_point coords, int impact_radius)
+{
+    if ( not t.alive or not tank_hit(t, coords, impact_radius) )
+    {
+        return 0;
+    }
+
+    int damage = 5 * (TANK_RADIUS + impact_radius - point_distance(coords, tank_center(t)));
+
+    return max(damage, 0);
+}
+
+/**
+ * Does the explosion touch the tank? In the hull's own frame the closest hull
+ * point is either on the arc or on the flat base.
+ */
+bool tank_hit(const tank &t, const world_point coords, int impact_radius)
+{
+    world_point local = hull_point(t, coords);
+    world_point closest;
+
+    if ( local.y >= 0 )
+    {
+        closest.x = max(-double(TANK_RADIUS), min(local.x, double(TANK_RADIUS)));
+        closest.y = 0;
+    }
+    else
+    {
+        double d = sqrt(local.x * local.x + local.y * local.y);
+        if ( d <= TANK_RADIUS ) return true;
+        closest.x = local.x * TANK_RADIUS / d;
+        closest.y = local.y * TANK_RADIUS / d;
+    }
+
+    return point_distance(local, closest) <= impact_radius;
+}
+
+bool tank_contains(const tank &t, const world_point &point)
+{
+    return hull_contains(hull_point(t, point));
+}
+
+/**
+ * The hull is convex, so a segment is inside it for one stretch, which starts
+ * either where the segment does, where it crosses the arc on the way in, or
+ * where it comes up through the flat base. Turning the segment into the
+ * hull's frame keeps the fractions along it the same.
+ */
+double tank_contact(const tank &t, const world_point &from, const world_point &to)
+{
+    // however the hull leans it stays inside the circle around its base, so
+    // nothing above that circle or beside it can touch it
+    if ( max(from.y, to.y) < t.coords.y or
+         min(from.y, to.y) > t.coords.y + 2 * TANK_RADIUS or
+         max(from.x, to.x) < t.coords.x or
+         min(from.x, to.x) > t.coords.x + 2 * TANK_RADIUS )
+    {
+        return NO_CONTACT;
+    }
+
+    world_point start = hull_point(t, from);
+    world_point end = hull_point(t, to);
+    if ( hull_contains(start) )
+    {
+        return 0;
+    }
+
+    double fx = start.x;
+    double fy = start.y;
+    double dx = end.x - start.x;
+    double dy = end.y - start.y;
+    double contact = NO_CONTACT;
+
+    // the nearer crossing of the circle, if it is on the top half
+    double a = dx * dx + dy * dy;
+    double b = 2 * (fx * dx + fy * dy);
+    double c = fx * fx + fy * fy - TANK_RADIUS * TANK_RADIUS;
+    double discriminant = b * b - 4 * a * c;
+    if ( a > 0 and discriminant >= 0 )
+    {
+        double entry = (-b - sqrt(discriminant)) / (2 * a);
+        if ( entry >= 0 and entry <= 1 and fy + entry * dy <= 0 )
+        {
+            contact = entry;
+        }
+    }
+
+    // coming up through the base
+    if ( dy < 0 and fy >= 0 and fy + dy < 0 )
+    {
+        double across = -fy / dy;
+        if ( abs(fx + across * dx) <= TANK_RADIUS )
+        {
+            contact = min(contact, across);
+        }
+    }
+
+    // rounding can't be allowed to miss a segment that ends inside
+    if ( contact == NO_CONTACT and hull_contains(end) )
+    {
+        contact = 1;
+    }
+
+    return contact;
+}
+
+/**
+ * A point in the tank's own frame: measured from the middle of its base and
+ * turned back by its base angle, the same turn draw_tank gives the bitmap, so
+ * the hull is always the top half of a circle of TANK_RADIUS sitting on y = 0.
+ */
+world_point hull_point(const tank &t, const world_point &p)
+{
+    world_point local;
+    double c = cos_deg(t.base_angle);
+    double s = sin_deg(t.base_angle);
+    double dx = p.x - (t.coords.x + TANK_RADIUS);
+    double dy = p.y - (t.coords.y + TANK_RADIUS);
+
+    local.x = dx * c + dy * s;
+    local.y = dy * c - dx * s;
+
+    return local;
+}
+
+/**
+ * is a point in the hull's own frame inside the hull?
+ */
+bool hull_contains(const world_point &local)
+{
+    return local.y < 0 and local.x * local.x + local.y * local.y <= TANK_RADIUS * TANK_RADIUS;
+}
+
+/**
+ * Oh no!
+ */
+void destroy_tank(world &w, tank &t)
+{
+    emit_tank_event(w, t, TANK_DESTROYED);
+    t.health = 0;
+    t.alive = false;
+}
+
+/**
+ * Let the front end know something happened to this tank.
+ */
+void emit_tank_event(world &w, const tank &t, world_event_kind kind)
+{
+    world_event e;
+
+    e.kind = kind;
+    e.tank_id = t.id;
+    e.coords = t.coords;
+    e.radius = 0;
+    e.first_column = 0;
+    e.last_column = 0;
+
+    w.events.push_back(e);
+}
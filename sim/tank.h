@@ -0,0 +1,196 @@
+#ifndef TANK_H_
+#define TANK_H_ 
+
+#include "sim.h"
+
+// constants
+#define TANK_MAX_ANGLE 175
+#define TANK_MIN_ANGLE 5
+#define TANK_MAX_POWER 120
+#define TANK_MIN_POWER 20
+#define TANK_RADIUS 12
+
+// how far a tank can lean before its turret runs out of room
+#define MAX_BASE_ANGLE 80
+
+// falling tanks drop this many pixels a tick, and turn a degree a tick once
+// down; INSTANT_FALL puts them straight at rest
+#define FALL_SPEED 3.0
+#define INSTANT_FALL 0.0
+
+/**
+ * Create and return a new tank with a known integer id.
+ *
+ * @param    the id
+ * @returns  the new tank
+ */
+tank new_tank(int id);
+
+/**
+ * Initialize the tank, ready for a game.
+ *
+ * @param   the tank to initialize
+ * @param   the random stream to place it with
+ * @param   how wide the world it is placed in is
+ */
+void initialize_tank(tank &t, random_stream &r, int world_width);
+
+/**
+ * Sets the tank name to a generated AI name.
+ *
+ * @param   the tank to generate a name for
+ * @param   the random stream to pick the name with
+ */
+void generate_name(tank &t, random_stream &r);
+
+/**
+ * Return the center point of a tank.
+ *
+ * @param    the tank to find the center of
+ * @returns  a world_point representing the tank center
+ */
+world_point tank_center(const tank &t);
+
+/**
+ * Return the mid base point of the tank, which the turret pivots around.
+ *
+ * @param    the tank
+ * @returns  a world_point representing the middle of the tank base
+ */
+world_point mid_base_point(const tank &t);
+
+/**
+ * Where the end of the tank's turret would be at a turret angle.
+ *
+ * @param    the tank
+ * @param    the turret angle
+ * @returns  the end of its turret
+ */
+world_point turret_end_point(const tank &t, int turret_angle);
+
+/**
+ * Set the turret position (turret end) to match the turret angle.
+ *
+ * @param    the tank whose turret should be positioned
+ */
+void set_turret_position(tank &t);
+
+/**
+ * Increase the tank power.
+ *
+ * @param    the world the tank is in
+ * @param    the tank whose power should increase
+ */
+void power_up(world &w, tank &t);
+
+/**
+ * Decrease the tank power.
+ *
+ * @param    the world the tank is in
+ * @param    the tank whose power should decrease
+ */
+void power_down(world &w, tank &t);
+
+/**
+ * Increase the tank angle.
+ *
+ * @param    the world the tank is in
+ * @param    the tank whose angle should increase
+ */
+void angle_up(world &w, tank &t);
+
+/**
+ * Decrease the tank angle.
+ *
+ * @param    the world the tank is in
+ * @param    the tank whose angle should decrease
+ */
+void angle_down(world &w, tank &t);
+
+/**
+ * Shoot gun!
+ * 
+ * @param    the world the tank is in
+ * @param    the tank doing the shooting
+ */
+void shoot(world &w, tank &t);
+
+/**
+ * The tank falls towards its resting pose, simulating gravity. It drops (or
+ * is pushed up by dirt) at the given speed, then turns its base a degree at a
+ * time until it lies on the ground.
+ *
+ * @param    the tank that is falling
+ * @param    the ground that it is falling towards
+ * @param    how many pixels it falls a tick, or INSTANT_FALL to land at once
+ * @returns  whether it is still on its way to rest
+ */
+bool fall(tank &t, const terrain &ground, double speed);
+
+/**
+ * Where will the tank come to rest on the ground below it? The base settles
+ * on the convex hull of the column tops under it, along whichever edge of the hull
+ * passes under the middle of the base, so the answer comes in one step. The
+ * lean is rounded to a whole degree and the tank sits as low as it can at
+ * that lean without going into the ground.
+ *
+ * @param    the tank
+ * @param    the ground
+ * @returns  the pose it will rest in
+ */
+tank_pose resting_pose(const tank &t, const terrain &ground);
+
+/**
+ * Damages a tank from an explosion point. The closer the explosion is
+ * to the center of the tank, the greater the damage.
+ *
+ * @param    the world the tank is in
+ * @param    the tank to be damaged
+ * @param    the coordinates of the center of the explosion
+ * @param    the impact radius of the explosion
+ */
+void damage_tank(world &w, tank &t, const world_point coords, int impact_radius);
+
+/**
+ * How much damage an explosion would do to a tank, without doing it.
+ *
+ * @param    the tank that might be damaged
+ * @param    the coordinates of the center of the explosion
+ * @param    the impact radius of the explosion
+ * @returns  the damage, which is 0 if the explosion misses or the tank is dead
+ */
+int explosion_damage(const tank &t, const world_point coords, int impact_radius);
+
+/**
+ * Is the tank still falling? It is until it is in its resting pose. A
+ * sleeping tank is at rest without needing to look.
+ *
+ * @param   the tank
+ * @param   the ground
+ * @returns whether the tank is falling or stable
+ */
+bool falling(const tank &t, const terrain &ground);
+
+/**
+ * Does this point lie within the tank hull? The hull is the top half of a
+ * circle of TANK_RADIUS on the middle of the tank's base, leaning with its
+ * base angle just as it is drawn, so it needs no bitmap.
+ *
+ * @param   the tank
+ * @param   the point to check
+ * @returns whether the point is inside the tank
+ */
+bool tank_contains(const tank &t, const world_point &point);
+
+/**
+ * Where does a segment first touch the tank hull?
+ *
+ * @param   the tank
+ * @param   where the segment starts
+ * @param   where the segment ends
+ * @returns the fraction of the way along the segment it first touches the
+ *          hull, or NO_CONTACT if it never does
+ */
+double tank_contact(const tank &t, const world_point &from, const world_point &to);
+
+#endif
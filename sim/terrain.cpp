@@ -0,0 +1,750 @@
+#include "terrain.h"
+#include "random.h"
+#include "geometry.h"
+#include "terrain_noise.h"
+
+#include <algorithm> // max, min, sort, unique
+#include <climits>   // INT_MAX
+#include <cstdlib>   // abs
+#include <cmath>     // pow
+#include <thread>    // hardware_concurrency
+
+// constants
+#define TERRAIN_DEPTH_RANGE 300
+#define TERRAIN_INFLECTION_INTERVAL_RANGE 105
+#define TERRAIN_INFLECTION_INTERVAL_FLOOR 55
+
+// segments over fewer columns than this are checked against the tops
+// directly before searching the height index
+#define SHORT_SEGMENT_COLUMNS 8
+
+// loose dirt falls this many pixels a tick
+#define DIRT_FALL_SPEED 2
+
+// neighbouring columns can differ in height by this many pixels before the
+// higher one slides; every generator's steepest slopes stay inside it, so
+// untouched ground is already at rest
+#define DIRT_REPOSE 6
+
+// at most this many pixels slide off a column a tick
+#define DIRT_SLIDE_SPEED 2
+
+// each chunk starts with room for this many spans a column, so the craters
+// and tunnels of a match rarely grow one
+#define CHUNK_SPANS_PER_COLUMN 4
+
+// the carve scratch starts with room for a blast this many columns across,
+// wider than any weapon's
+#define CARVE_ROOM_COLUMNS 64
+
+// Forward declarations
+void generate_terrain_structure(vector<int> &surface, random_stream &r);
+void generate_new_function(world_point &start_coords, world_point &end_coords, double &slope,
+                           random_stream &r);
+void fill_below(terrain &t, const vector<int> &surface);
+bool carve_column(const terrain &t, int column, int carve_top, int carve_bottom, vector<terrain_span> &spans);
+void splice_columns(terrain &t, int first_column, int last_column, const vector<terrain_span> &spans,
+                    const vector<int> &first_span);
+void splice_chunk(terrain_chunk &chunk, int first, int last, const vector<terrain_span> &spans,
+                  const vector<int> &first_span, int from);
+int ground_column(const terrain &t, double x);
+double column_contact(const terrain &t, int column, const world_point &from, const world_point &to,
+                      double enter, double leave);
+double span_contact(const terrain_span &span, const world_point &from, const world_point &to, double enter,
+                    double leave, double enter_y, double leave_y);
+void set_top(terrain &t, int column, int top);
+void build_height_tree(terrain &t);
+int tree_highest(const terrain &t, int node, int node_first, int node_last, int first_column,
+                 int last_column);
+double tree_contact(const terrain &t, int node, int node_first, int node_last, const world_point &from,
+                    const world_point &to, int first_column, int last_column);
+double boundary_fraction(const world_point &from, const world_point &to, double boundary);
+void erase_span(terrain_chunk &chunk, int x, int i);
+void insert_span(terrain_chunk &chunk, int x, int i, const terrain_span &span);
+void update_top(terrain &t, int column);
+bool drop_spans(terrain &t, int column);
+bool slide_column(terrain &t, int column, int &neighbour);
+
+terrain new_terrain(random_stream &r, int width, terrain_preset preset)
+{
+    terrain t;
+    vector<int> surface(width);
+
+    t.width = width;
+    if ( preset == CLASSIC_TERRAIN )
+    {
+        generate_terrain_structure(surface, r);
+    }
+    else
+    {
+        generate_noise_surface(r.key, preset, width, thread::hardware_concurrency(), surface);
+    }
+    fill_below(t, surface);
+    t.unsettled.assign(width, false);
+    // a column is only ever listed once
+    t.settling.reserve(width);
+    t.settling_now.reserve(width);
+    t.carved_spans.reserve(CARVE_ROOM_COLUMNS * CHUNK_SPANS_PER_COLUMN);
+    t.carved_first_span.reserve(CARVE_ROOM_COLUMNS + 1);
+
+    return t;
+}
+
+/**
+ * Generate the structure for a terrain. The structure is composed of a series of
+ * hills and valleys of varying height/depth at irregular intervals. Stucture is
+ * generated using a series of linear functions with random slope.
+ */
+void generate_terrain_structure(vector<int> &surface, random_stream &r)
+{
+    world_point start_coords, end_coords;
+    double slope;
+
+    // the initial end coords will become the starting coordinates for the first function
+    end_coords.x = 0;
+    end_coords.y = WORLD_HEIGHT / 3 + random_int(r, TERRAIN_DEPTH_RANGE + 1);
+
+    generate_new_function(start_coords, end_coords, slope, r);
+
+    for ( int x = 0; x < surface.size(); x++ )
+    {
+        // y = m x + c (calculate the current value of y for the current x)
+        surface[x] = slope * (x - start_coords.x) + start_coords.y;
+
+        // if we have reached the end of the current function, generate a new one
+        if ( x >= end_coords.x )
+        {
+            generate_new_function(start_coords, end_coords, slope, r);
+        }
+    }
+}
+
+/**
+ * Generates a linear function to generate terrain and sets the starting coordinates,
+ * ending coordinates and slope.
+ */
+void generate_new_function(world_point &start_coords, world_point &end_coords, double &slope,
+                           random_stream &r)
+{
+    // the new start coordinates are the old end coordinates
+    start_coords.x = end_coords.x;
+    start_coords.y = end_coords.y;
+    end_coords.x += random_int(r, TERRAIN_INFLECTION_INTERVAL_RANGE + 1) + TERRAIN_INFLECTION_INTERVAL_FLOOR;
+    end_coords.y = WORLD_HEIGHT / 3 + random_int(r, TERRAIN_DEPTH_RANGE + 1);
+    slope = (end_coords.y - start_coords.y) / (end_coords.x - start_coords.x);
+}
+
+/**
+ * Everything below the surface starts out solid: one span per column, from
+ * just under the surface down to the bottom of the world. Chunks get room
+ * for more, so carving into them doesn't have to grow them.
+ */
+void fill_below(terrain &t, const vector<int> &surface)
+{
+    t.chunks.resize((t.width + TERRAIN_CHUNK_COLUMNS - 1) / TERRAIN_CHUNK_COLUMNS);
+    t.tops.resize(t.width);
+    for ( int c = 0; c < t.chunks.size(); c++ )
+    {
+        terrain_chunk &chunk = t.chunks[c];
+        int first = c * TERRAIN_CHUNK_COLUMNS;
+        int columns = min(TERRAIN_CHUNK_COLUMNS, t.width - first);
+
+        chunk.spans.clear();
+        chunk.spans.reserve(columns * CHUNK_SPANS_PER_COLUMN);
+        chunk.first_span.resize(columns + 1);
+        for ( int x = 0; x < columns; x++ )
+        {
+            chunk.first_span[x] = chunk.spans.size();
+            t.tops[first + x] = min(surface[first + x] + 1, WORLD_HEIGHT);
+            if ( t.tops[first + x] < WORLD_HEIGHT )
+            {
+                terrain_span span;
+                span.top = t.tops[first + x];
+                span.bottom = WORLD_HEIGHT;
+                chunk.spans.push_back(span);
+            }
+        }
+        chunk.first_span[columns] = chunk.spans.size();
+    }
+    build_height_tree(t);
+}
+
+void column_span_range(const terrain &t, int column, const terrain_span *&first, const terrain_span *&last)
+{
+    const terrain_chunk &chunk = t.chunks[column / TERRAIN_CHUNK_COLUMNS];
+    int x = column % TERRAIN_CHUNK_COLUMNS;
+
+    first = chunk.spans.data() + chunk.first_span[x];
+    last = chunk.spans.data() + chunk.first_span[x + 1];
+}
+
+/**
+ * fill in the whole height index from tops
+ */
+void build_height_tree(terrain &t)
+{
+    t.tree_leaves = 1;
+    while ( t.tree_leaves < t.width )
+    {
+        t.tree_leaves *= 2;
+    }
+
+    t.highest.resize(2 * t.tree_leaves);
+    for ( int i = 0; i < t.tree_leaves; i++ )
+    {
+        // columns past the edge of the world are never asked about
+        t.highest[t.tree_leaves + i] = ( i < t.width ) ? t.tops[i] : INT_MAX;
+    }
+    for ( int node = t.tree_leaves - 1; node >= 1; node-- )
+    {
+        t.highest[node] = min(t.highest[2 * node], t.highest[2 * node + 1]);
+    }
+}
+
+/**
+ * Change one column's top, and the height index with it: just the column's
+ * leaf and the nodes above it.
+ */
+void set_top(terrain &t, int column, int top)
+{
+    t.tops[column] = top;
+
+    int node = t.tree_leaves + column;
+    t.highest[node] = top;
+    for ( node /= 2; node >= 1; node /= 2 )
+    {
+        t.highest[node] = min(t.highest[2 * node], t.highest[2 * node + 1]);
+    }
+}
+
+int highest_ground(const terrain &t, int first_column, int last_column)
+{
+    first_column = max(first_column, 0);
+    last_column = min(last_column, t.width - 1);
+    if ( first_column > last_column ) return WORLD_HEIGHT;
+
+    return tree_highest(t, 1, 0, t.tree_leaves - 1, first_column, last_column);
+}
+
+/**
+ * the highest ground in the columns both under a node and in the range
+ */
+int tree_highest(const terrain &t, int node, int node_first, int node_last, int first_column,
+                 int last_column)
+{
+    if ( node_last < first_column or node_first > last_column )
+    {
+        return INT_MAX;
+    }
+    if ( node_first >= first_column and node_last <= last_column )
+    {
+        return t.highest[node];
+    }
+
+    int middle = (node_first + node_last) / 2;
+    return min(tree_highest(t, 2 * node, node_first, middle, first_column, last_column),
+               tree_highest(t, 2 * node + 1, middle + 1, node_last, first_column, last_column));
+}
+
+bool touches_ground(const terrain &t, const world_point &point)
+{
+    int column = ground_column(t, point.x);
+
+    if ( point.y >= WORLD_HEIGHT )
+    {
+        return true;
+    }
+
+    const terrain_span *span, *last;
+    for ( column_span_range(t, column, span, last); span < last; span++ )
+    {
+        if ( point.y >= span->top and point.y < span->bottom )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+double ground_contact(const terrain &t, const world_point &from, const world_point &to)
+{
+    int first_column = ground_column(t, min(from.x, to.x));
+    int last_column = ground_column(t, max(from.x, to.x));
+
+    // a shot's step only spans a column or two, and is usually nowhere near
+    // the ground, which a look at those tops shows quicker than the tree
+    if ( last_column - first_column < SHORT_SEGMENT_COLUMNS )
+    {
+        int highest = t.tops[first_column];
+        for ( int c = first_column + 1; c <= last_column; c++ )
+        {
+            highest = min(highest, t.tops[c]);
+        }
+        if ( max(from.y, to.y) < highest )
+        {
+            return NO_CONTACT;
+        }
+    }
+
+    return tree_contact(t, 1, 0, t.tree_leaves - 1, from, to, first_column, last_column);
+}
+
+/**
+ * Where a segment first touches the ground under one node of the height
+ * index. Any node whose highest ground is below the lowest the segment gets
+ * over it is skipped whole, so only the columns the segment comes down near
+ * are ever looked at one by one. Children are searched in the order the
+ * segment reaches them, so the first contact found is the first along it.
+ */
+double tree_contact(const terrain &t, int node, int node_first, int node_last, const world_point &from,
+                    const world_point &to, int first_column, int last_column)
+{
+    if ( node_last < first_column or node_first > last_column )
+    {
+        return NO_CONTACT;
+    }
+
+    // the part of the segment over the node's columns; the edge columns
+    // carry on past the sides of the world
+    int covered_first = max(node_first, first_column);
+    int covered_last = min(node_last, last_column);
+    double enter = 0;
+    double leave = 1;
+    if ( from.x != to.x )
+    {
+        double left = ( covered_first == first_column ) ? ( (to.x > from.x) ? 0 : 1 )
+                                                        : boundary_fraction(from, to, covered_first);
+        double right = ( covered_last == last_column ) ? ( (to.x > from.x) ? 1 : 0 )
+                                                       : boundary_fraction(from, to, covered_last + 1);
+        enter = min(left, right);
+        leave = max(left, right);
+    }
+
+    double lowest = max(point_along(from, to, enter).y, point_along(from, to, leave).y);
+    if ( lowest < t.highest[node] )
+    {
+        return NO_CONTACT;
+    }
+    if ( node_first == node_last )
+    {
+        return column_contact(t, node_first, from, to, enter, leave);
+    }
+
+    int middle = (node_first + node_last) / 2;
+    int near = ( to.x >= from.x ) ? 2 * node : 2 * node + 1;
+    int near_first = ( to.x >= from.x ) ? node_first : middle + 1;
+    int near_last = ( to.x >= from.x ) ? middle : node_last;
+    int far_first = ( to.x >= from.x ) ? middle + 1 : node_first;
+    int far_last = ( to.x >= from.x ) ? node_last : middle;
+
+    double contact = tree_contact(t, near, near_first, near_last, from, to, first_column, last_column);
+    if ( contact != NO_CONTACT )
+    {
+        return contact;
+    }
+    return tree_contact(t, 4 * node + 1 - near, far_first, far_last, from, to, first_column, last_column);
+}
+
+/**
+ * how far along a segment it crosses the boundary on the left of a column
+ */
+double boundary_fraction(const world_point &from, const world_point &to, double boundary)
+{
+    return (boundary - from.x) / (to.x - from.x);
+}
+
+/**
+ * the column of terrain under an x coordinate, with the edge columns carrying
+ * on past the sides of the world
+ */
+int ground_column(const terrain &t, double x)
+{
+    return min(max(int(x), 0), t.width - 1);
+}
+
+/**
+ * where the part of a segment over one column first touches any of the
+ * column's spans, or the bedrock beneath them
+ */
+double column_contact(const terrain &t, int column, const world_point &from, const world_point &to,
+                      double enter, double leave)
+{
+    double enter_y = point_along(from, to, enter).y;
+    double leave_y = point_along(from, to, leave).y;
+
+    terrain_span bedrock;
+    bedrock.top = WORLD_HEIGHT;
+    bedrock.bottom = INT_MAX;
+    double contact = span_contact(bedrock, from, to, enter, leave, enter_y, leave_y);
+
+    const terrain_span *span, *last;
+    for ( column_span_range(t, column, span, last); span < last; span++ )
+    {
+        contact = min(contact, span_contact(*span, from, to, enter, leave, enter_y, leave_y));
+    }
+
+    return contact;
+}
+
+/**
+ * Where the part of a segment over a column first gets inside one span: where
+ * it starts, or where it comes down through the top or up through the bottom.
+ */
+double span_contact(const terrain_span &span, const world_point &from, const world_point &to, double enter,
+                    double leave, double enter_y, double leave_y)
+{
+    if ( enter_y >= span.top and enter_y < span.bottom )
+    {
+        return enter;
+    }
+
+    double edge;
+    if ( enter_y < span.top and leave_y >= span.top )
+    {
+        edge = span.top;
+    }
+    else if ( enter_y >= span.bottom and leave_y < span.bottom )
+    {
+        edge = span.bottom;
+    }
+    else
+    {
+        return NO_CONTACT;
+    }
+
+    return max(enter, min(leave, (edge - from.y) / (to.y - from.y)));
+}
+
+/**
+ * The blast carves an oval out of each column it reaches, taller than it is
+ * wide, wherever the dirt is: off the surface, out of a hillside or from the
+ * roof of a tunnel, leaving anything above or below it where it was. Only the
+ * columns under the blast are looked at, however wide the world.
+ */
+void destroy_terrain(terrain &t, const world_point coords, int impact_radius, int &first_column,
+                     int &last_column)
+{
+    int center = floor(coords.x);
+    int blast_first = max(center - impact_radius, 0);
+    int blast_last = min(center + impact_radius - 1, t.width - 1);
+
+    first_column = t.width;
+    last_column = -1;
+    if ( blast_first > blast_last ) return;
+
+    // a carve splits a span in two at most once per column, so this is room
+    // for everything; the scratch starts with room for any weapon's blast and
+    // keeps it, so this only allocates on ground already riddled with spans
+    vector<terrain_span> &spans = t.carved_spans;
+    vector<int> &first_span = t.carved_first_span;
+    int room = 0;
+    for ( int x = blast_first; x <= blast_last; x++ )
+    {
+        const terrain_span *first, *last;
+        column_span_range(t, x, first, last);
+        room += last - first + 1;
+    }
+    spans.clear();
+    first_span.clear();
+    spans.reserve(room);
+    first_span.reserve(blast_last - blast_first + 2);
+    for ( int x = blast_first; x <= blast_last; x++ )
+    {
+        int i = x - center;
+        int impact = (int)round(sqrt(pow(impact_radius, 2) - pow(abs(i), 2)) * 1.3);
+        int carve_top = (int)round(coords.y - impact);
+        int carve_bottom = (int)round(coords.y + impact) + 1;
+
+        first_span.push_back(spans.size());
+        if ( carve_column(t, x, carve_top, carve_bottom, spans) )
+        {
+            first_column = min(first_column, x);
+            last_column = max(last_column, x);
+        }
+    }
+    first_span.push_back(spans.size());
+
+    splice_columns(t, blast_first, blast_last, spans, first_span);
+
+    // the crater walls and anything left hanging over it may now be loose
+    if ( first_column <= last_column )
+    {
+        unsettle_terrain(t, first_column - 1, last_column + 1);
+    }
+}
+
+/**
+ * Append a column's spans with the rows from the carve top down to the carve
+ * bottom taken out, splitting any span the carve lands inside. Returns
+ * whether any dirt was actually taken.
+ */
+bool carve_column(const terrain &t, int column, int carve_top, int carve_bottom, vector<terrain_span> &spans)
+{
+    bool carved = false;
+    const terrain_span *next, *last;
+
+    for ( column_span_range(t, column, next, last); next < last; next++ )
+    {
+        terrain_span span = *next;
+        if ( carve_top >= carve_bottom or span.bottom <= carve_top or span.top >= carve_bottom )
+        {
+            spans.push_back(span);
+            continue;
+        }
+
+        carved = true;
+        if ( span.top < carve_top )
+        {
+            terrain_span above = span;
+            above.bottom = carve_top;
+            spans.push_back(above);
+        }
+        if ( span.bottom > carve_bottom )
+        {
+            terrain_span below = span;
+            below.top = carve_bottom;
+            spans.push_back(below);
+        }
+    }
+
+    return carved;
+}
+
+void unsettle_terrain(terrain &t, int first_column, int last_column)
+{
+    for ( int x = max(first_column, 0); x <= min(last_column, t.width - 1); x++ )
+    {
+        if ( not t.unsettled[x] )
+        {
+            t.unsettled[x] = true;
+            t.settling.push_back(x);
+        }
+    }
+}
+
+/**
+ * Only the columns on the worklist are looked at. A column that changes puts
+ * itself and its neighbours back on the list for the next tick, and one that
+ * doesn't has come to rest and drops off it.
+ */
+void settle_terrain(terrain &t, vector<int> &changed)
+{
+    // the two lists swap, so both keep their room from tick to tick
+    vector<int> &columns = t.settling_now;
+
+    changed.clear();
+    columns.swap(t.settling);
+    t.settling.clear();
+    // left to right, so the same craters always settle the same way
+    sort(columns.begin(), columns.end());
+    for ( int i = 0; i < columns.size(); i++ )
+    {
+        t.unsettled[columns[i]] = false;
+    }
+
+    for ( int i = 0; i < columns.size(); i++ )
+    {
+        int neighbour;
+        bool dropped = drop_spans(t, columns[i]);
+        bool slid = slide_column(t, columns[i], neighbour);
+        if ( dropped or slid )
+        {
+            changed.push_back(columns[i]);
+        }
+        if ( slid )
+        {
+            changed.push_back(neighbour);
+        }
+    }
+
+    sort(changed.begin(), changed.end());
+    changed.erase(unique(changed.begin(), changed.end()), changed.end());
+    for ( int i = 0; i < changed.size(); i++ )
+    {
+        unsettle_terrain(t, changed[i] - 1, changed[i] + 1);
+    }
+}
+
+/**
+ * Replace the spans of a run of columns with new ones, given in the same
+ * packed form with offsets from the start of the new spans, and bring their
+ * tops up to date. The run is spliced a chunk at a time.
+ */
+void splice_columns(terrain &t, int first_column, int last_column, const vector<terrain_span> &spans,
+                    const vector<int> &first_span)
+{
+    int x = first_column;
+    while ( x <= last_column )
+    {
+        int chunk_first = x - x % TERRAIN_CHUNK_COLUMNS;
+        int chunk_last = min(last_column, chunk_first + TERRAIN_CHUNK_COLUMNS - 1);
+        splice_chunk(t.chunks[x / TERRAIN_CHUNK_COLUMNS], x - chunk_first, chunk_last - chunk_first, spans,
+                     first_span, x - first_column);
+        x = chunk_last + 1;
+    }
+
+    for ( int x = first_column; x <= last_column; x++ )
+    {
+        update_top(t, x);
+    }
+}
+
+/**
+ * Splice the new spans from the from'th column of the run in over a chunk's
+ * columns first to last. If the number of spans changes, only the spans and
+ * offsets after them in this chunk move.
+ */
+void splice_chunk(terrain_chunk &chunk, int first, int last, const vector<terrain_span> &spans,
+                  const vector<int> &first_span, int from)
+{
+    int start = chunk.first_span[first];
+    int count = chunk.first_span[last + 1] - start;
+    int new_start = first_span[from];
+    int new_count = first_span[from + last - first + 1] - new_start;
+
+    if ( new_count == count )
+    {
+        copy(spans.begin() + new_start, spans.begin() + new_start + new_count, chunk.spans.begin() + start);
+    }
+    else
+    {
+        chunk.spans.erase(chunk.spans.begin() + start, chunk.spans.begin() + start + count);
+        chunk.spans.insert(chunk.spans.begin() + start, spans.begin() + new_start,
+                           spans.begin() + new_start + new_count);
+        for ( int x = last + 1; x < chunk.first_span.size(); x++ )
+        {
+            chunk.first_span[x] += new_count - count;
+        }
+    }
+    for ( int x = first + 1; x <= last; x++ )
+    {
+        chunk.first_span[x] = start + first_span[from + x - first] - new_start;
+    }
+}
+
+/**
+ * Spans with a gap under them fall towards whatever is below, lowest first so
+ * a span that lands joins the one it lands on. The spans are moved where they
+ * are, in the column's chunk. Returns whether anything fell.
+ */
+bool drop_spans(terrain &t, int column)
+{
+    terrain_chunk &chunk = t.chunks[column / TERRAIN_CHUNK_COLUMNS];
+    int x = column % TERRAIN_CHUNK_COLUMNS;
+    vector<terrain_span> &spans = chunk.spans;
+    bool dropped = false;
+
+    for ( int i = chunk.first_span[x + 1] - 1; i >= chunk.first_span[x]; i-- )
+    {
+        bool on_bedrock = i + 1 == chunk.first_span[x + 1];
+        int support = on_bedrock ? WORLD_HEIGHT : spans[i + 1].top;
+        int fall = min(DIRT_FALL_SPEED, support - spans[i].bottom);
+        if ( fall <= 0 ) continue;
+
+        dropped = true;
+        spans[i].top += fall;
+        spans[i].bottom += fall;
+        if ( spans[i].bottom == support and not on_bedrock )
+        {
+            spans[i + 1].top = spans[i].top;
+            erase_span(chunk, x, i);
+        }
+    }
+
+    if ( dropped )
+    {
+        update_top(t, column);
+    }
+    return dropped;
+}
+
+/**
+ * If a column stands too far above the lower of its neighbours, some dirt
+ * slides off its top onto the neighbour's, both changed where they are.
+ * Returns whether any did, and which neighbour it went to.
+ */
+bool slide_column(terrain &t, int column, int &neighbour)
+{
+    int drop = 0;
+
+    neighbour = column;
+    for ( int x = column - 1; x <= column + 1; x += 2 )
+    {
+        if ( x >= 0 and x < t.width and t.tops[x] - t.tops[column] > drop )
+        {
+            drop = t.tops[x] - t.tops[column];
+            neighbour = x;
+        }
+    }
+    if ( drop <= DIRT_REPOSE ) return false;
+
+    // move just enough to bring the two within repose, a little at a time
+    int amount = min(DIRT_SLIDE_SPEED, (drop - DIRT_REPOSE + 1) / 2);
+
+    terrain_chunk &from = t.chunks[column / TERRAIN_CHUNK_COLUMNS];
+    int x = column % TERRAIN_CHUNK_COLUMNS;
+    terrain_span &top = from.spans[from.first_span[x]];
+    amount = min(amount, top.bottom - top.top);
+    top.top += amount;
+    if ( top.top == top.bottom )
+    {
+        erase_span(from, x, from.first_span[x]);
+    }
+    update_top(t, column);
+
+    terrain_chunk &to = t.chunks[neighbour / TERRAIN_CHUNK_COLUMNS];
+    x = neighbour % TERRAIN_CHUNK_COLUMNS;
+    if ( to.first_span[x] == to.first_span[x + 1] )
+    {
+        terrain_span pile;
+        pile.top = WORLD_HEIGHT - amount;
+        pile.bottom = WORLD_HEIGHT;
+        insert_span(to, x, to.first_span[x], pile);
+    }
+    else
+    {
+        to.spans[to.first_span[x]].top -= amount;
+    }
+    update_top(t, neighbour);
+
+    return true;
+}
+
+/**
+ * take the i'th span of a chunk out of its column x
+ */
+void erase_span(terrain_chunk &chunk, int x, int i)
+{
+    chunk.spans.erase(chunk.spans.begin() + i);
+    for ( int k = x + 1; k < chunk.first_span.size(); k++ )
+    {
+        chunk.first_span[k]--;
+    }
+}
+
+/**
+ * put a span into a chunk's column x as its i'th span
+ */
+void insert_span(terrain_chunk &chunk, int x, int i, const terrain_span &span)
+{
+    chunk.spans.insert(chunk.spans.begin() + i, span);
+    for ( int k = x + 1; k < chunk.first_span.size(); k++ )
+    {
+        chunk.first_span[k]++;
+    }
+}
+
+/**
+ * bring a column's top up to date with its spans
+ */
+void update_top(terrain &t, int column)
+{
+    const terrain_span *first, *last;
+
+    column_span_range(t, column, first, last);
+    int top = ( last > first ) ? first->top : WORLD_HEIGHT;
+    if ( top != t.tops[column] )
+    {
+        set_top(t, column, top);
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef TERRAIN_H_
+#define TERRAIN_H_ 
+
+#include "sim.h"
+
+// columns are kept in chunks this many columns wide
+#define TERRAIN_CHUNK_COLUMNS 64
+
+/**
+ * Generates and returns a new terrain object. Each column along the x axis
+ * starts out solid from its surface down to the bottom of the world.
+ *
+ * @param    the random stream to generate from
+ * @param    how many columns wide the terrain is
+ * @param    the kind of landscape to generate
+ * @returns  the generated terrain
+ */
+terrain new_terrain(random_stream &r, int width, terrain_preset preset);
+
+/**
+ * Where one column's spans are, from the top down.
+ *
+ * @param    the terrain the column is in
+ * @param    the column
+ * @param    set to the column's first span
+ * @param    set to just past the column's last span
+ */
+void column_span_range(const terrain &t, int column, const terrain_span *&first, const terrain_span *&last);
+
+/**
+ * Affirms whether or not a point touches the ground: whether it is inside any
+ * solid span of its column or below the bottom of the world.
+ *
+ * @param    the terrain to check in
+ * @param    the point to check for
+ * @returns  whether the point touches the ground
+ */
+bool touches_ground(const terrain &t, const world_point &point);
+
+/**
+ * The highest ground, which is the smallest top, in a range of columns. The
+ * terrain keeps a segment tree over the tops, so this takes logarithmic time
+ * however wide the range. Columns outside the world are ignored; an empty
+ * range is WORLD_HEIGHT.
+ *
+ * @param    the terrain to check in
+ * @param    the first column of the range
+ * @param    the last column of the range
+ * @returns  the top of the highest ground in the range
+ */
+int highest_ground(const terrain &t, int first_column, int last_column);
+
+/**
+ * Where does a segment first touch the ground? The segment is checked against
+ * every column it passes over, so it finds ground a single point test at
+ * either end would step straight over. Stretches of columns whose highest
+ * ground the segment stays above are skipped using the height index, so a
+ * long ray over open ground, like a line of sight, takes logarithmic time.
+ *
+ * @param    the terrain to check in
+ * @param    where the segment starts
+ * @param    where the segment ends
+ * @returns  the fraction of the way along the segment it first touches the
+ *           ground, or NO_CONTACT if it never does
+ */
+double ground_contact(const terrain &t, const world_point &from, const world_point &to);
+
+/**
+ * Destroys terrain around a central point, carving an oval hole through
+ * whatever dirt is there, so blasts under an overhang or inside a hill leave
+ * tunnels with ground still above them. The columns that
+ * actually changed are reported back; if none did, the first is past the
+ * last.
+ *
+ * @param    the terrain to be damaged
+ * @param    the coordinates of the center of the destruction
+ * @param    the impact radius to be destroyed to
+ * @param    set to the first column changed
+ * @param    set to the last column changed
+ */
+void destroy_terrain(terrain &t, const world_point coords, int impact_radius, int &first_column,
+                     int &last_column);
+
+/**
+ * Put columns on the settling worklist, because dirt in them may have been
+ * left hanging or piled too steep. Columns outside the world are ignored.
+ *
+ * @param    the terrain the columns are in
+ * @param    the first column to settle
+ * @param    the last column to settle
+ */
+void unsettle_terrain(terrain &t, int first_column, int last_column);
+
+/**
+ * Settle the terrain for one tick. Each column on the worklist lets any dirt
+ * with a gap under it fall a little, and slides a little dirt off its top
+ * onto a neighbour that is too far below it. Columns that come to rest leave
+ * the worklist, so ground that isn't settling costs nothing.
+ *
+ * @param    the terrain to settle
+ * @param    set to the columns that changed, in order
+ */
+void settle_terrain(terrain &t, vector<int> &changed);
+
+#endif
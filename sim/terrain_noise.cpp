@@ -0,0 +1,188 @@
+#include "terrain_noise.h"
+#include "random.h"
+
+#include <algorithm> // max, min
+#include <thread>    // splitting wide worlds
+
+// constants
+#define NOISE_MAX_LAYERS 4
+#define NOISE_BASE_HEIGHT (WORLD_HEIGHT / 2)
+#define NOISE_HIGHEST (WORLD_HEIGHT / 6)
+#define NOISE_LOWEST (WORLD_HEIGHT - 60)
+
+// worlds narrower than this many columns a thread aren't worth splitting
+#define NOISE_THREAD_COLUMNS 65536
+
+// how much of a step layer's wavelength its slope takes up
+#define NOISE_STEP_RAMP 0.3
+
+/**
+ * How a layer blends from one random height to the next.
+ */
+enum noise_shape
+{
+    LINEAR_NOISE,
+    SMOOTH_NOISE,
+    STEP_NOISE
+};
+
+/**
+ * One layer of noise: random heights between plus and minus the amplitude,
+ * every wavelength columns.
+ */
+struct noise_layer
+{
+    int wavelength;
+    double amplitude;
+    noise_shape shape;
+};
+
+/**
+ * The layers making up a preset, widest first. Every preset keeps its
+ * steepest slope under the dirt's angle of repose, so untouched ground never
+ * settles.
+ */
+struct noise_preset
+{
+    int layers;
+    noise_layer layer[NOISE_MAX_LAYERS];
+};
+
+const noise_preset ROLLING_HILLS_LAYERS = { 4, { { 640, 110, SMOOTH_NOISE }, { 320, 55, SMOOTH_NOISE },
+                                                 { 160, 25, SMOOTH_NOISE }, { 80, 10, SMOOTH_NOISE } } };
+const noise_preset PLATEAUS_LAYERS = { 3, { { 360, 110, STEP_NOISE }, { 720, 60, SMOOTH_NOISE },
+                                            { 40, 3, LINEAR_NOISE } } };
+const noise_preset MOUNTAINS_LAYERS = { 4, { { 300, 150, LINEAR_NOISE }, { 110, 45, LINEAR_NOISE },
+                                             { 500, 60, SMOOTH_NOISE }, { 30, 5, LINEAR_NOISE } } };
+
+// forward declarations
+const noise_preset &preset_layers(terrain_preset preset);
+void fill_noise_columns(uint64_t key, const noise_preset &layers, int first_column, int last_column,
+                        vector<int> &surface);
+double lattice_height(uint64_t key, const noise_layer &layer, int point);
+void add_noise_cell(double *__restrict heights, int count, int offset, double scale, double from, double to,
+                    noise_shape shape);
+
+void generate_noise_surface(uint64_t key, terrain_preset preset, int width, int threads, vector<int> &surface)
+{
+    const noise_preset &layers = preset_layers(preset);
+    int chunks = max(1, min(threads, (width + NOISE_THREAD_COLUMNS - 1) / NOISE_THREAD_COLUMNS));
+    int chunk_width = (width + chunks - 1) / chunks;
+    vector<thread> workers;
+
+    surface.resize(width);
+    for ( int i = 1; i < chunks; i++ )
+    {
+        int first = i * chunk_width;
+        int last = min(first + chunk_width, width) - 1;
+        workers.push_back(thread([=, &layers, &surface]() {
+            fill_noise_columns(key, layers, first, last, surface);
+        }));
+    }
+    fill_noise_columns(key, layers, 0, min(chunk_width, width) - 1, surface);
+    for ( int i = 0; i < workers.size(); i++ )
+    {
+        workers[i].join();
+    }
+}
+
+/**
+ * the layers that make up a preset
+ */
+const noise_preset &preset_layers(terrain_preset preset)
+{
+    switch ( preset )
+    {
+        case PLATEAUS: return PLATEAUS_LAYERS;
+        case MOUNTAINS: return MOUNTAINS_LAYERS;
+        case ROLLING_HILLS:
+        default: return ROLLING_HILLS_LAYERS;
+    }
+}
+
+/**
+ * Fill in the surface for a run of columns. Each layer is added a cell at a
+ * time, the stretch between two of its random heights, so the inner loop is
+ * plain arithmetic over a run of columns that vectorizes.
+ */
+void fill_noise_columns(uint64_t key, const noise_preset &layers, int first_column, int last_column,
+                        vector<int> &surface)
+{
+    int count = last_column - first_column + 1;
+    vector<double> heights(count, NOISE_BASE_HEIGHT);
+
+    for ( int l = 0; l < layers.layers; l++ )
+    {
+        const noise_layer &layer = layers.layer[l];
+        uint64_t layer_key = new_random_stream(key, l + 1).key;
+
+        for ( int cell = first_column / layer.wavelength; cell <= last_column / layer.wavelength; cell++ )
+        {
+            int cell_x = cell * layer.wavelength;
+            int first = max(cell_x, first_column);
+            int last = min(cell_x + layer.wavelength - 1, last_column);
+
+            add_noise_cell(heights.data() + (first - first_column), last - first + 1, first - cell_x,
+                           1.0 / layer.wavelength, lattice_height(layer_key, layer, cell),
+                           lattice_height(layer_key, layer, cell + 1), layer.shape);
+        }
+    }
+
+    for ( int i = 0; i < count; i++ )
+    {
+        surface[first_column + i] = min(max(int(heights[i]), NOISE_HIGHEST), NOISE_LOWEST);
+    }
+}
+
+/**
+ * the random height a layer has at one of its points, a wavelength apart
+ */
+double lattice_height(uint64_t key, const noise_layer &layer, int point)
+{
+    random_stream r;
+
+    r.key = key;
+    r.counter = point;
+
+    return layer.amplitude * (2 * random_double(r) - 1);
+}
+
+/**
+ * Add one cell of a layer to a run of columns: the blend from one height to
+ * the next, a scale of the way across per column, starting offset columns
+ * into the cell. Each shape has its own loop so none of them branch.
+ */
+void add_noise_cell(double *__restrict heights, int count, int offset, double scale, double from, double to,
+                    noise_shape shape)
+{
+    double rise = to - from;
+
+    switch ( shape )
+    {
+        case LINEAR_NOISE:
+            for ( int i = 0; i < count; i++ )
+            {
+                double t = (offset + i) * scale;
+                heights[i] += from + rise * t;
+            }
+            break;
+        case SMOOTH_NOISE:
+            for ( int i = 0; i < count; i++ )
+            {
+                double t = (offset + i) * scale;
+                heights[i] += from + rise * t * t * (3 - 2 * t);
+            }
+            break;
+        case STEP_NOISE:
+            // flat for most of the cell, then a smooth climb to the next
+            // height; t never passes 1, so the ramp only needs clamping below
+            for ( int i = 0; i < count; i++ )
+            {
+                double t = (offset + i) * scale;
+                double ramp = (t - (1 - NOISE_STEP_RAMP)) / NOISE_STEP_RAMP;
+                ramp = ( ramp > 0 ) ? ramp : 0;
+                heights[i] += from + rise * ramp * ramp * (3 - 2 * ramp);
+            }
+            break;
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef TERRAIN_NOISE_H_
+#define TERRAIN_NOISE_H_
+
+#include "sim.h"
+
+/**
+ * Work out the surface of a noise terrain preset. Each layer of the preset is
+ * a row of random heights a wavelength apart, blended between by a straight
+ * line, a smooth curve or a sharp step, and the layers are added together.
+ * The height of any column depends only on the key and the column, so very
+ * wide worlds are split across threads and every thread count gives the same
+ * surface.
+ *
+ * @param    the key the surface follows from
+ * @param    the preset to generate; not CLASSIC_TERRAIN
+ * @param    how many columns wide the surface is
+ * @param    at most how many threads to split the work across
+ * @param    set to the surface height of every column
+ */
+void generate_noise_surface(uint64_t key, terrain_preset preset, int width, int threads, vector<int> &surface);
+
+#endif
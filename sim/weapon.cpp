@@ -0,0 +1,460 @@
+#include "weapon.h"
+#include "shot.h"
+#include "world.h"
+#include "geometry.h"
+
+#include <algorithm> // max, remove_if
+#include <cassert>   // assert
+#include <cmath>     // abs
+
+// constants
+#define BOMBLET_RADIUS 5
+#define CLUSTER_RADIUS 10
+#define DIGGER_RADIUS 10
+
+// the weapons before this one can be picked; the rest are only split into
+#define PICKABLE_WEAPONS BOMBLET
+
+// a MIRV splits into this many warheads, each this much faster across than
+// the one before it
+#define MIRV_WARHEADS 5
+#define MIRV_SPREAD 6.0
+#define MIRV_MIN_POWER 2.0
+
+// a cluster bomb throws this many bomblets up between these angles, at one of
+// a few powers
+#define CLUSTER_BOMBLETS 30
+#define CLUSTER_MIN_ANGLE 30
+#define CLUSTER_MAX_ANGLE 150
+#define CLUSTER_MIN_POWER 20
+#define CLUSTER_POWER_STEP 8
+#define CLUSTER_POWER_STEPS 3
+
+// rollers move this many columns a tick, and go off after this many ticks if
+// they never find the bottom
+#define ROLLER_SPEED 2
+#define ROLLER_FUSE 180
+
+// diggers tunnel this many pixels a tick, clearing a tunnel this wide either
+// side, and go off after this many ticks
+#define DIGGER_SPEED 3.0
+#define DIGGER_TUNNEL 4
+#define DIGGER_FUSE 30
+
+/**
+ * What a weapon is called and how big a blast it makes.
+ */
+struct weapon_stats
+{
+    const char *name;
+    int blast_radius;
+};
+
+// the catalogue, in weapon_kind order
+const weapon_stats WEAPONS[] =
+{
+    { "SHELL", EXPLOSION_MAX_RADIUS },
+    { "MIRV", EXPLOSION_MAX_RADIUS },
+    { "CLUSTER BOMB", CLUSTER_RADIUS },
+    { "ROLLER", EXPLOSION_MAX_RADIUS },
+    { "DIGGER", DIGGER_RADIUS },
+    { "BOMBLET", BOMBLET_RADIUS }
+};
+
+// forward declarations
+void spawn_projectile(world &w, weapon_kind weapon, const shot &flight, bool lead);
+bool projectile_tick(world &w, projectile &p);
+bool spent(const projectile &p);
+bool fly(world &w, projectile &p, bool &landed, bool &on_tank);
+void blow_up(world &w, const projectile &p);
+bool shell_tick(world &w, projectile &p);
+bool mirv_tick(world &w, projectile &p);
+void split_mirv(world &w, const projectile &p);
+bool cluster_tick(world &w, projectile &p);
+bool roller_tick(world &w, projectile &p);
+void land_roller(world &w, projectile &p);
+bool roll(world &w, projectile &p);
+bool digger_tick(world &w, projectile &p);
+
+const char *weapon_name(weapon_kind weapon)
+{
+    return WEAPONS[weapon].name;
+}
+
+weapon_kind next_weapon(weapon_kind weapon)
+{
+    return weapon_kind((weapon + 1) % PICKABLE_WEAPONS);
+}
+
+void fire_weapon(world &w, tank &t)
+{
+    spawn_projectile(w, t.weapon, t.active_shot, true);
+}
+
+void projectiles_tick(world &w)
+{
+    // anything split off this tick is added past the end, and waits for the
+    // next. Each projectile is ticked as a copy and put back, so nothing is
+    // left pointing into the pool while spawning adds to it
+    int count = w.projectiles.size();
+
+    for ( int i = 0; i < count; i++ )
+    {
+        projectile p = w.projectiles[i];
+        p.spent = not projectile_tick(w, p);
+        if ( p.lead )
+        {
+            w.tanks[p.flight.owner_id - 1].active_shot = p.flight;
+        }
+        w.projectiles[i] = p;
+    }
+    w.projectiles.erase(remove_if(w.projectiles.begin(), w.projectiles.end(), spent), w.projectiles.end());
+}
+
+/**
+ * add a projectile to the pool, if there is room for it. The pool is reserved
+ * when the world is made or copied, so adding to it never allocates
+ */
+void spawn_projectile(world &w, weapon_kind weapon, const shot &flight, bool lead)
+{
+    if ( w.projectiles.size() < MAX_PROJECTILES )
+    {
+        assert(w.projectiles.size() < w.projectiles.capacity());
+        projectile p;
+        p.weapon = weapon;
+        p.flight = flight;
+        p.lead = lead;
+        p.grounded = false;
+        p.spent = false;
+        p.heading.x = 0;
+        p.heading.y = 0;
+        p.fuse = 0;
+        w.projectiles.push_back(p);
+    }
+}
+
+/**
+ * one tick of whatever the projectile's weapon does. Returns whether it is
+ * still going
+ */
+bool projectile_tick(world &w, projectile &p)
+{
+    switch ( p.weapon )
+    {
+        case MIRV:
+            return mirv_tick(w, p);
+        case CLUSTER_BOMB:
+            return cluster_tick(w, p);
+        case ROLLER:
+            return roller_tick(w, p);
+        case DIGGER:
+            return digger_tick(w, p);
+        default:
+            return shell_tick(w, p);
+    }
+}
+
+/**
+ * is the projectile finished with?
+ */
+bool spent(const projectile &p)
+{
+    return p.spent;
+}
+
+/**
+ * A tick of flight, moved just as the world has always moved shots: the step
+ * taken last tick is checked for a hit, then the next step is taken. Returns
+ * whether it is still flying. If not, landed says whether it hit something,
+ * and its coordinates are moved to where, rather than it leaving the world.
+ * On tank says whether what it hit first was a tank, judged over the whole
+ * step, since the contact point itself sits right on the tank's edge.
+ */
+bool fly(world &w, projectile &p, bool &landed, bool &on_tank)
+{
+    shot &s = p.flight;
+    double first = shot_contact(w, s.previous, s.coords);
+
+    landed = first != NO_CONTACT;
+    on_tank = false;
+    if ( landed )
+    {
+        on_tank = tanks_contact(w, s.previous, s.coords) == first;
+        s.coords = point_along(s.previous, s.coords, first);
+        return false;
+    }
+    if ( shot_off_world(w, s.coords) )
+    {
+        return false;
+    }
+    move_shot(s, w.wind_strength);
+    return true;
+}
+
+/**
+ * the projectile goes off where it is, with its weapon's blast
+ */
+void blow_up(world &w, const projectile &p)
+{
+    explode(w, p.flight, WEAPONS[p.weapon].blast_radius);
+}
+
+/**
+ * shells, warheads and bomblets fly until they hit something, and go off
+ */
+bool shell_tick(world &w, projectile &p)
+{
+    bool landed, on_tank;
+
+    if ( fly(w, p, landed, on_tank) )
+    {
+        return true;
+    }
+    if ( landed )
+    {
+        blow_up(w, p);
+    }
+    return false;
+}
+
+/**
+ * MIRVs fly like shells, but split into warheads as soon as they start to fall
+ */
+bool mirv_tick(world &w, projectile &p)
+{
+    if ( not shell_tick(w, p) )
+    {
+        return false;
+    }
+    if ( p.flight.coords.y > p.flight.previous.y )
+    {
+        split_mirv(w, p);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Warheads carry on from where the MIRV split, each faster or slower across
+ * than it was going, so they land spread either side of where it would have.
+ * The middle one takes over the lead.
+ */
+void split_mirv(world &w, const projectile &p)
+{
+    const shot &s = p.flight;
+    double across = s.power * cos_deg(s.initial_angle);
+
+    for ( int i = 0; i < MIRV_WARHEADS; i++ )
+    {
+        double speed = across + (i - MIRV_WARHEADS / 2) * MIRV_SPREAD;
+
+        // falling from the top of its flight, a warhead starts out level
+        shot warhead = s;
+        warhead.initial_x = s.coords.x;
+        warhead.initial_y = s.coords.y;
+        warhead.initial_angle = ( speed < 0 ) ? 180 : 0;
+        warhead.power = max(abs(speed), MIRV_MIN_POWER);
+        warhead.distance = s.coords.x;
+        spawn_projectile(w, SHELL, warhead, p.lead and i == MIRV_WARHEADS / 2);
+    }
+}
+
+/**
+ * Cluster bombs fly like shells, then throw bomblets up out of the crater
+ * they make. One that bursts on a tank has nothing to throw them out of, so a
+ * direct hit is just the one blast.
+ */
+bool cluster_tick(world &w, projectile &p)
+{
+    bool landed, on_tank;
+
+    if ( fly(w, p, landed, on_tank) )
+    {
+        return true;
+    }
+    if ( not landed )
+    {
+        return false;
+    }
+
+    const shot &s = p.flight;
+    blow_up(w, p);
+    if ( on_tank )
+    {
+        return false;
+    }
+    for ( int i = 0; i < CLUSTER_BOMBLETS; i++ )
+    {
+        shot bomblet = s;
+        bomblet.initial_x = s.coords.x;
+        bomblet.initial_y = s.coords.y;
+        bomblet.initial_angle = CLUSTER_MIN_ANGLE + i * (CLUSTER_MAX_ANGLE - CLUSTER_MIN_ANGLE) / (CLUSTER_BOMBLETS - 1);
+        bomblet.power = CLUSTER_MIN_POWER + (i % CLUSTER_POWER_STEPS) * CLUSTER_POWER_STEP;
+        bomblet.distance = s.coords.x;
+        bomblet.previous = s.coords;
+        spawn_projectile(w, BOMBLET, bomblet, false);
+    }
+    return false;
+}
+
+/**
+ * Rollers fly like shells until they land. On a tank they go off at once; on
+ * the ground they roll downhill along it.
+ */
+bool roller_tick(world &w, projectile &p)
+{
+    bool landed, on_tank;
+
+    if ( p.grounded )
+    {
+        return roll(w, p);
+    }
+    if ( fly(w, p, landed, on_tank) )
+    {
+        return true;
+    }
+    if ( not landed )
+    {
+        return false;
+    }
+    if ( on_tank )
+    {
+        blow_up(w, p);
+        return false;
+    }
+    land_roller(w, p);
+    return true;
+}
+
+/**
+ * put the roller on top of the column it landed in, facing downhill, or the
+ * way it was flying if the ground is flat
+ */
+void land_roller(world &w, projectile &p)
+{
+    const terrain &ground = w.game_terrain;
+    shot &s = p.flight;
+    int column = min(max(int(s.coords.x), 0), ground.width - 1);
+    int left = ground.tops[max(column - 1, 0)];
+    int right = ground.tops[min(column + 1, ground.width - 1)];
+
+    if ( left != right )
+    {
+        p.heading.x = ( right > left ) ? 1 : -1;
+    }
+    else
+    {
+        p.heading.x = ( s.coords.x >= s.previous.x ) ? 1 : -1;
+    }
+    p.grounded = true;
+    p.fuse = ROLLER_FUSE;
+    s.previous = s.coords;
+    s.coords.x = column + 0.5;
+    s.coords.y = ground.tops[column] - 1;
+}
+
+/**
+ * The roller moves along the tops until the ground ahead rises, where it
+ * goes off. It also goes off on running into a tank or when its fuse runs
+ * out, and is lost if it rolls off the edge of the world.
+ */
+bool roll(world &w, projectile &p)
+{
+    const terrain &ground = w.game_terrain;
+    shot &s = p.flight;
+    int column = int(s.coords.x);
+    bool bottom = false;
+
+    s.previous = s.coords;
+    for ( int i = 0; i < ROLLER_SPEED and not bottom; i++ )
+    {
+        int next = column + int(p.heading.x);
+        if ( next < 0 or next >= ground.width )
+        {
+            return false;
+        }
+        if ( ground.tops[next] < ground.tops[column] )
+        {
+            bottom = true;
+        }
+        else
+        {
+            column = next;
+        }
+    }
+    s.coords.x = column + 0.5;
+    s.coords.y = ground.tops[column] - 1;
+
+    double hit = tanks_contact(w, s.previous, s.coords);
+    if ( hit != NO_CONTACT )
+    {
+        s.coords = point_along(s.previous, s.coords, hit);
+        bottom = true;
+    }
+    p.fuse--;
+    if ( bottom or p.fuse == 0 )
+    {
+        blow_up(w, p);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Diggers fly like shells until they land. On a tank they go off at once; in
+ * the ground they tunnel on the way they were flying, clearing the dirt as
+ * they go, and go off on running into a tank, reaching the base of the world
+ * or when their fuse runs out.
+ */
+bool digger_tick(world &w, projectile &p)
+{
+    shot &s = p.flight;
+
+    if ( not p.grounded )
+    {
+        bool landed, on_tank;
+        if ( fly(w, p, landed, on_tank) )
+        {
+            return true;
+        }
+        if ( not landed )
+        {
+            return false;
+        }
+        if ( on_tank )
+        {
+            blow_up(w, p);
+            return false;
+        }
+
+        double length = point_distance(s.previous, s.coords);
+        p.heading.x = ( length > 0 ) ? (s.coords.x - s.previous.x) / length : 0;
+        p.heading.y = ( length > 0 ) ? (s.coords.y - s.previous.y) / length : 1;
+        p.grounded = true;
+        p.fuse = DIGGER_FUSE;
+    }
+
+    s.previous = s.coords;
+    s.coords.x += p.heading.x * DIGGER_SPEED;
+    s.coords.y += p.heading.y * DIGGER_SPEED;
+    if ( shot_off_world(w, s.coords) )
+    {
+        return false;
+    }
+
+    double hit = tanks_contact(w, s.previous, s.coords);
+    if ( hit != NO_CONTACT )
+    {
+        s.coords = point_along(s.previous, s.coords, hit);
+        blow_up(w, p);
+        return false;
+    }
+    p.fuse--;
+    if ( p.fuse == 0 or s.coords.y >= WORLD_HEIGHT - 2 )
+    {
+        blow_up(w, p);
+        return false;
+    }
+    carve_terrain(w, s.coords, DIGGER_TUNNEL, s.owner_id);
+    return true;
+}
@@ -0,0 +1,48 @@
+#ifndef WEAPON_H_
+#define WEAPON_H_
+
+#include "sim.h"
+
+// the projectile pool never holds more than this many at once; anything a
+// weapon would split into past it is lost
+#define MAX_PROJECTILES 64
+
+/**
+ * The name of a weapon, to show whoever is picking one.
+ *
+ * @param    the weapon
+ * @returns  its name
+ */
+const char *weapon_name(weapon_kind weapon);
+
+/**
+ * The weapon after this one in the list a tank can pick from, coming back
+ * round to the shell after the last.
+ *
+ * @param    the weapon picked now
+ * @returns  the next weapon
+ */
+weapon_kind next_weapon(weapon_kind weapon);
+
+/**
+ * Launch the tank's weapon as the lead projectile in the world's pool, flying
+ * from the tank's active shot.
+ *
+ * @param    the world to fire into
+ * @param    the tank firing, which has just set up its active shot
+ */
+void fire_weapon(world &w, tank &t);
+
+/**
+ * Every projectile in the pool moves on by one tick. Whatever each does, from
+ * flying to splitting, rolling, digging or exploding, is picked by a switch
+ * on its weapon kind, so every behaviour is a direct call. Whatever it splits
+ * into joins the pool to move on from the next tick. Spent projectiles are
+ * dropped from the pool, and the lead projectile's flight is copied into its
+ * tank's active shot.
+ *
+ * @param    the world whose projectiles move
+ */
+void projectiles_tick(world &w);
+
+#endif
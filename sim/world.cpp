@@ -0,0 +1,546 @@
+#include "world.h"
+#include "brain.h"
+#include "tank.h"
+#include "terrain.h"
+#include "shot.h"
+#include "random.h"
+#include "firing_table.h"
+#include "geometry.h"
+#include "weapon.h"
+
+#include <algorithm> // find, max, min
+#include <cmath>     // floor
+#include <cstdlib>   // abs
+
+// room for every event a busy tick raises, such as a cluster bomb's bomblets
+// all going off together, so front ends that drain the events each tick
+// never make them grow
+#define EVENTS_RESERVED 256
+
+// forward declarations
+void ai_tick(world &w);
+void terrain_tick(world &w);
+void tank_tick(world &w);
+void shot_tick(world &w);
+void wind_tick(world &w);
+void next_player(world &w);
+void end_match(world &w);
+void end_on_rounds(world &w);
+void finish_match(world &w, world_event_kind kind);
+void activate_random_tank(world &w);
+void initialize_tanks(world &w);
+bool tanks_too_close(const tank &t1, const tank &t2);
+void build_tank_cells(world &w);
+void move_tank_cells(world &w, int i, const world_point &before);
+int tank_cell(const world &w, double x);
+
+world new_world(uint64_t seed, int width, terrain_preset preset)
+{
+    world w;
+
+    w.seed = seed;
+    w.terrain_random = new_random_stream(seed, TERRAIN_STREAM);
+    w.wind_random = new_random_stream(seed, WIND_STREAM);
+    w.spawn_random = new_random_stream(seed, SPAWN_STREAM);
+    w.game_terrain = new_terrain(w.terrain_random, width, preset);
+    w.fall_speed = FALL_SPEED;
+    w.projectiles.reserve(MAX_PROJECTILES);
+    w.nearby.reserve(MAX_PLAYERS);
+    w.events.reserve(EVENTS_RESERVED);
+    // settling lists a column and the neighbour it slid onto at most
+    w.settled.reserve(2 * width);
+    w.active_tank = NULL;
+    w.wind_strength = 0.0;
+    w.round = 0;
+    w.max_rounds = NO_ROUND_LIMIT;
+    w.over = false;
+
+    return w;
+}
+
+void start_match(world &w)
+{
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        w.tanks[i].ai.random = new_random_stream(w.seed, AI_STREAM + w.tanks[i].id);
+        w.tanks[i].asleep = false;
+        w.awake_tanks.push_back(i);
+    }
+    activate_random_tank(w);
+    initialize_tanks(w);
+    build_tank_cells(w);
+}
+
+world copy_world(const world &w)
+{
+    world copy = w;
+
+    copy.events.clear();
+    copy.projectiles.reserve(MAX_PROJECTILES);
+    copy.nearby.reserve(MAX_PLAYERS);
+    if ( w.active_tank )
+    {
+        copy.active_tank = &(copy.tanks[w.active_tank - &(w.tanks[0])]);
+    }
+    for ( int i = 0; i < copy.tanks.size(); i++ )
+    {
+        brain &b = copy.tanks[i].ai;
+        if ( b.target )
+        {
+            b.target = &(copy.tanks[b.target - &(w.tanks[0])]);
+        }
+        if ( b.last_shot )
+        {
+            b.last_shot = &(copy.tanks[i].active_shot);
+        }
+        b.pending = shared_future<brain_decision>();
+    }
+
+    return copy;
+}
+
+void tick(world &w)
+{
+    ai_tick(w);
+    terrain_tick(w);
+    tank_tick(w);
+    shot_tick(w);
+    wind_tick(w);
+}
+
+/**
+ * ai does ai things for one tick
+ */
+void ai_tick(world &w)
+{
+    if ( w.active_tank->is_ai and not w.active_tank->shooting )
+    {
+        // think may only be checking on a worker, so lets get tick happening before and after
+        if ( w.active_tank->ai.state == READY )
+        {
+            act(w);
+        }
+        if ( w.active_tank->ai.state == THINKING )
+        {
+            think(w);
+        }
+        if ( w.active_tank->ai.state == WAITING )
+        {
+            w.active_tank->ai.state = THINKING;
+        }
+    }
+}
+
+/**
+ * loose dirt settles for one tick. Each run of neighbouring columns that
+ * changed is reported on its own, and since settling can pile dirt up as well
+ * as take it away, any shot that flew over them needs tracing again
+ */
+void terrain_tick(world &w)
+{
+    vector<int> &changed = w.settled;
+
+    settle_terrain(w.game_terrain, changed);
+
+    int i = 0;
+    while ( i < changed.size() )
+    {
+        int j = i;
+        while ( j + 1 < changed.size() and changed[j + 1] == changed[j] + 1 )
+        {
+            j++;
+        }
+
+        world_event e;
+        e.kind = TERRAIN_CHANGED;
+        e.tank_id = 0;
+        e.coords.x = changed[i];
+        e.coords.y = w.game_terrain.tops[changed[i]];
+        e.radius = 0;
+        e.first_column = changed[i];
+        e.last_column = changed[j];
+        w.events.push_back(e);
+
+        invalidate_crossings(w, changed[i], changed[j]);
+        wake_tanks(w, changed[i], changed[j]);
+        i = j + 1;
+    }
+}
+
+/**
+ * awake tanks fall for one tick, and any shots that flew where a tank moved
+ * or leaned need tracing again. Tanks that come to rest go to sleep
+ */
+void tank_tick(world &w)
+{
+    int still_awake = 0;
+
+    for ( int k = 0; k < w.awake_tanks.size(); k++ )
+    {
+        int i = w.awake_tanks[k];
+        world_point before = w.tanks[i].coords;
+        int before_angle = w.tanks[i].base_angle;
+        bool moving = fall(w.tanks[i], w.game_terrain, w.fall_speed);
+
+        world_point after = w.tanks[i].coords;
+        if ( before.x != after.x or before.y != after.y )
+        {
+            move_tank_cells(w, i, before);
+        }
+        if ( before.x != after.x or before.y != after.y or before_angle != w.tanks[i].base_angle )
+        {
+            invalidate_crossings(w, int(min(before.x, after.x)),
+                                 int(max(before.x, after.x)) + 2 * TANK_RADIUS + 1);
+        }
+
+        if ( moving )
+        {
+            w.awake_tanks[still_awake++] = i;
+        }
+        else
+        {
+            w.tanks[i].asleep = true;
+        }
+    }
+    w.awake_tanks.resize(still_awake);
+}
+
+/**
+ * every projectile the active tank fired moves on for one tick, and once the
+ * last of them is gone the turn passes on
+ */
+void shot_tick(world &w)
+{
+    if ( w.active_tank->shooting )
+    {
+        projectiles_tick(w);
+        if ( w.projectiles.empty() )
+        {
+            w.active_tank->shooting = false;
+            next_player(w);
+        }
+    }
+}
+
+/**
+ * the wind shifts randomly over time
+ */
+void wind_tick(world &w)
+{
+    double chance = random_double(w.wind_random);
+
+    // the wind shouldn't adjust excessively quickly
+    if ( chance < 0.03 and w.wind_strength > -1.0 )
+    {
+        w.wind_strength -= 0.01;
+    }
+    else if ( chance < 0.06 and w.wind_strength < 1.0 )
+    {
+        w.wind_strength += 0.01;
+    }
+}
+
+bool shot_hits(const world &w, const world_point &from, const world_point &to, world_point &contact)
+{
+    double first = shot_contact(w, from, to);
+
+    if ( first == NO_CONTACT )
+    {
+        return false;
+    }
+    contact = point_along(from, to, first);
+    return true;
+}
+
+double shot_contact(const world &w, const world_point &from, const world_point &to)
+{
+    double first = ground_contact(w.game_terrain, from, to);
+
+    // the base of the world
+    double base = WORLD_HEIGHT - 2;
+    if ( from.y >= base )
+    {
+        first = 0;
+    }
+    else if ( to.y >= base )
+    {
+        first = min(first, (base - from.y) / (to.y - from.y));
+    }
+
+    return min(first, tanks_contact(w, from, to));
+}
+
+double tanks_contact(const world &w, const world_point &from, const world_point &to)
+{
+    double first = NO_CONTACT;
+
+    // a tank in two cells is tried twice, which can't change the first contact
+    int last_cell = tank_cell(w, max(from.x, to.x));
+    for ( int c = tank_cell(w, min(from.x, to.x)); c <= last_cell; c++ )
+    {
+        const vector<int> &cell = w.tank_cells[c];
+        for ( int i = 0; i < cell.size(); i++ )
+        {
+            first = min(first, tank_contact(w.tanks[cell[i]], from, to));
+        }
+    }
+
+    return first;
+}
+
+void tanks_near(const world &w, double left, double right, vector<int> &found)
+{
+    int first_cell = tank_cell(w, left);
+    int last_cell = tank_cell(w, right);
+
+    found.clear();
+    for ( int c = first_cell; c <= last_cell; c++ )
+    {
+        const vector<int> &cell = w.tank_cells[c];
+        for ( int i = 0; i < cell.size(); i++ )
+        {
+            // a tank in more than one cell is only taken from the first of
+            // them in the range
+            const tank &t = w.tanks[cell[i]];
+            if ( c == max(first_cell, tank_cell(w, t.coords.x)) and t.coords.x <= right and
+                 t.coords.x + 2 * TANK_RADIUS >= left )
+            {
+                found.push_back(cell[i]);
+            }
+        }
+    }
+}
+
+void wake_tanks(world &w, int first_column, int last_column)
+{
+    vector<int> &near = w.nearby;
+
+    tanks_near(w, first_column, last_column + 1, near);
+    for ( int i = 0; i < near.size(); i++ )
+    {
+        if ( w.tanks[near[i]].asleep )
+        {
+            w.tanks[near[i]].asleep = false;
+            w.awake_tanks.push_back(near[i]);
+        }
+    }
+}
+
+bool shot_off_world(const world &w, const world_point &coords)
+{
+    return coords.x >= w.game_terrain.width or coords.x <= 0;
+}
+
+/**
+ * select the next player, unless the game has been won
+ */
+void next_player(world &w)
+{
+    if ( game_won(w) )
+    {
+        end_match(w);
+    }
+    else
+    {
+        if ( w.active_tank->id == w.tanks.size() )
+        {
+            w.active_tank = &(w.tanks[0]);
+            w.round++;
+        }
+        else
+        {
+            w.active_tank = &(w.tanks[w.active_tank->id]);
+        }
+        if ( w.max_rounds != NO_ROUND_LIMIT and w.round >= w.max_rounds )
+        {
+            end_on_rounds(w);
+        }
+        else if ( not w.active_tank->alive )
+        {
+            next_player(w);
+        }
+    }
+}
+
+bool game_won(const world &w)
+{
+    int alive = 0;
+
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        if ( w.tanks[i].alive )
+        {
+            alive++;
+        }
+    }
+
+    return alive <= 1;
+}
+
+/**
+ * the last tank standing becomes the active tank and the match is over. If
+ * the last of them went down together, the match is drawn
+ */
+void end_match(world &w)
+{
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        if ( w.tanks[i].alive )
+        {
+            w.active_tank = &(w.tanks[i]);
+            finish_match(w, MATCH_WON);
+            return;
+        }
+    }
+
+    finish_match(w, MATCH_DRAWN);
+}
+
+/**
+ * The rounds have run out, so the tank left with the most health wins. If
+ * more than one share the most, the match is drawn.
+ */
+void end_on_rounds(world &w)
+{
+    tank *leader = NULL;
+    bool tied = false;
+
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        tank &t = w.tanks[i];
+        if ( not t.alive ) continue;
+
+        if ( leader and t.health == leader->health )
+        {
+            tied = true;
+        }
+        else if ( not leader or t.health > leader->health )
+        {
+            leader = &t;
+            tied = false;
+        }
+    }
+
+    if ( tied )
+    {
+        finish_match(w, MATCH_DRAWN);
+    }
+    else
+    {
+        w.active_tank = leader;
+        finish_match(w, MATCH_WON);
+    }
+}
+
+/**
+ * Tell front ends how the match ended and stop it. A won match is won by
+ * the active tank; a drawn one has no tank.
+ */
+void finish_match(world &w, world_event_kind kind)
+{
+    world_event e;
+    e.kind = kind;
+    e.tank_id = ( kind == MATCH_WON ) ? w.active_tank->id : 0;
+    e.coords = w.active_tank->coords;
+    e.radius = 0;
+    e.first_column = 0;
+    e.last_column = 0;
+    w.events.push_back(e);
+
+    w.over = true;
+}
+
+/**
+ * picks a random tank to start the game
+ */
+void activate_random_tank(world &w)
+{
+    w.active_tank = &(w.tanks[random_int(w.spawn_random, w.tanks.size())]);
+}
+
+/**
+ * repeatedly reinitialize tanks until they're not too close to each other
+ */
+void initialize_tanks(world &w)
+{
+    bool acceptable;
+    int i = 0;
+    while ( i < w.tanks.size() )
+    {
+        initialize_tank(w.tanks[i], w.spawn_random, w.game_terrain.width);
+        acceptable = true;
+        for ( int j = 0; j < i; j++ )
+        {
+            if ( tanks_too_close(w.tanks[j], w.tanks[i]) )
+            {
+                acceptable = false;
+            }
+        }
+        if ( acceptable ) i++;
+    }
+}
+
+/**
+ * put every tank in the broad phase cells its hull reaches
+ */
+void build_tank_cells(world &w)
+{
+    int cells = (w.game_terrain.width + TANK_CELL_WIDTH - 1) / TANK_CELL_WIDTH;
+
+    w.tank_cells.assign(cells, vector<int>());
+    for ( int i = 0; i < w.tanks.size(); i++ )
+    {
+        int last_cell = tank_cell(w, w.tanks[i].coords.x + 2 * TANK_RADIUS);
+        for ( int c = tank_cell(w, w.tanks[i].coords.x); c <= last_cell; c++ )
+        {
+            w.tank_cells[c].push_back(i);
+        }
+    }
+}
+
+/**
+ * A tank has moved from where it was to where it is: take it out of the cells
+ * it has left and add it to the ones it has reached. Falling tanks mostly stay
+ * in the same cells, so there is usually nothing to do.
+ */
+void move_tank_cells(world &w, int i, const world_point &before)
+{
+    int old_first = tank_cell(w, before.x);
+    int old_last = tank_cell(w, before.x + 2 * TANK_RADIUS);
+    int new_first = tank_cell(w, w.tanks[i].coords.x);
+    int new_last = tank_cell(w, w.tanks[i].coords.x + 2 * TANK_RADIUS);
+
+    for ( int c = old_first; c <= old_last; c++ )
+    {
+        if ( c < new_first or c > new_last )
+        {
+            vector<int> &cell = w.tank_cells[c];
+            cell.erase(find(cell.begin(), cell.end(), i));
+        }
+    }
+    for ( int c = new_first; c <= new_last; c++ )
+    {
+        if ( c < old_first or c > old_last )
+        {
+            w.tank_cells[c].push_back(i);
+        }
+    }
+}
+
+/**
+ * the broad phase cell an x coordinate is in, with the edge cells carrying on
+ * past the sides of the world
+ */
+int tank_cell(const world &w, double x)
+{
+    return min(max(int(floor(x / TANK_CELL_WIDTH)), 0), int(w.tank_cells.size()) - 1);
+}
+
+/**
+ * are these tanks too close to spawn at this range?
+ */
+bool tanks_too_close(const tank &t1, const tank &t2)
+{
+    return abs(int(t1.coords.x - t2.coords.x)) < MIN_PLAYER_GAP;
+}
+
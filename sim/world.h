@@ -0,0 +1,129 @@
+#ifndef WORLD_H_
+#define WORLD_H_
+
+#include "sim.h"
+
+#define MIN_PLAYER_GAP 60
+#define MAX_PLAYERS 64
+
+// the width of a cell in the broad phase over tanks
+#define TANK_CELL_WIDTH 64
+
+// the simulation always advances in fixed steps of this length
+#define TICKS_PER_SECOND 60
+#define TICK_SECONDS (1.0 / TICKS_PER_SECOND)
+
+// a world's max rounds when matches play on until someone wins
+#define NO_ROUND_LIMIT 0
+
+/**
+ * Create and return a new world with freshly generated terrain and no tanks.
+ * Everything random in the world follows from the seed.
+ *
+ * @param    the seed for the match
+ * @param    how many columns wide the world is
+ * @param    the kind of landscape to generate
+ * @returns  the new world
+ */
+world new_world(uint64_t seed, int width, terrain_preset preset);
+
+/**
+ * Start a match in the world: place every tank and pick who goes first.
+ *
+ * @param   the world to start a match in
+ */
+void start_match(world &w);
+
+/**
+ * Copy a world, pointing the copy's active tank and brain targets at its own
+ * tanks rather than the original's. The copy starts with no events.
+ *
+ * @param    the world to copy
+ * @returns  the independent copy
+ */
+world copy_world(const world &w);
+
+/**
+ * A world tick passes a unit of time: the ai, tanks, shots and wind all move on
+ * by one step. Anything noteworthy is appended to the world events.
+ *
+ * @param   the world to advance
+ */
+void tick(world &w);
+
+/**
+ * Has a shot moving between two points hit the ground, a tank or the base of
+ * the world anywhere along the way? However far the shot moved in a step, the
+ * contact point is exactly where it first touched.
+ *
+ * @param   the world the shot is in
+ * @param   where the shot was
+ * @param   where the shot is now
+ * @param   set to where the shot first touched something, if it did
+ * @returns whether the shot should explode
+ */
+bool shot_hits(const world &w, const world_point &from, const world_point &to, world_point &contact);
+
+/**
+ * How far a shot moving between two points gets before it first touches the
+ * ground, a tank or the base of the world, as shot_hits finds it.
+ *
+ * @param   the world the shot is in
+ * @param   where the shot was
+ * @param   where the shot is now
+ * @returns the fraction of the way along the first contact is, or NO_CONTACT
+ *          if there isn't one
+ */
+double shot_contact(const world &w, const world_point &from, const world_point &to);
+
+/**
+ * Where does a segment first touch any tank's hull, ignoring the ground?
+ *
+ * @param   the world the tanks are in
+ * @param   where the segment starts
+ * @param   where the segment ends
+ * @returns the fraction of the way along the segment it first touches a
+ *          tank, or NO_CONTACT if it never does
+ */
+double tanks_contact(const world &w, const world_point &from, const world_point &to);
+
+/**
+ * Find every tank whose hull reaches between two x coordinates, each once.
+ * Only the broad phase cells the range covers are looked at, so however many
+ * tanks are in the world this costs about as much as the tanks nearby.
+ *
+ * @param   the world the tanks are in
+ * @param   the left of the range
+ * @param   the right of the range
+ * @param   set to the indexes of the tanks found
+ */
+void tanks_near(const world &w, double left, double right, vector<int> &found);
+
+/**
+ * The ground in a range of columns changed, so any sleeping tank whose base
+ * reaches over it wakes up to fall again.
+ *
+ * @param   the world the tanks are in
+ * @param   the first column that changed
+ * @param   the last column that changed
+ */
+void wake_tanks(world &w, int first_column, int last_column);
+
+/**
+ * Is a shot at these coordinates off the horizontal edge of the world?
+ *
+ * @param   the world the shot is in
+ * @param   the coordinates of the shot
+ * @returns whether the shot has missed
+ */
+bool shot_off_world(const world &w, const world_point &coords);
+
+/**
+ * Has the match been won? This will be true if only one tank remains alive,
+ * or none do, when the last of them went down together.
+ *
+ * @param   the world that might have been won
+ */
+bool game_won(const world &w);
+
+#endif
@@ -0,0 +1,70 @@
+#include "match.h"
+#include "../sim/world.h"
+#include "../sim/tank.h"
+#include "../sim/brain.h"
+
+#include <chrono> // match timing
+
+// forward declarations
+void count_events(world &w, match_result &result);
+
+match_result play_match(const match_config &config)
+{
+    auto started = chrono::steady_clock::now();
+    match_result result;
+
+    world w = new_world(config.seed, config.width, config.preset);
+    w.fall_speed = INSTANT_FALL;
+    for ( int i = 0; i < config.players.size(); i++ )
+    {
+        tank t = new_tank(i + 1);
+        t.is_ai = true;
+        t.ai.variant = config.players[i];
+        t.ai.aim_speed = INSTANT_AIM;
+        w.tanks.push_back(t);
+    }
+    start_match(w);
+    w.max_rounds = config.max_rounds;
+
+    result.winner = 0;
+    result.drawn = false;
+    result.ticks = 0;
+    result.shots.assign(config.players.size(), 0);
+
+    while ( not w.over and result.ticks < config.max_ticks )
+    {
+        tick(w);
+        count_events(w, result);
+        result.ticks++;
+    }
+
+    if ( w.over and not result.drawn )
+    {
+        result.winner = w.active_tank->id;
+    }
+
+    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - started;
+    result.duration_ms = elapsed.count();
+
+    return result;
+}
+
+/**
+ * the only events a headless match cares about are shots being fired and
+ * the match being drawn
+ */
+void count_events(world &w, match_result &result)
+{
+    for ( int i = 0; i < w.events.size(); i++ )
+    {
+        if ( w.events[i].kind == SHOT_FIRED )
+        {
+            result.shots[w.events[i].tank_id - 1]++;
+        }
+        else if ( w.events[i].kind == MATCH_DRAWN )
+        {
+            result.drawn = true;
+        }
+    }
+    w.events.clear();
+}
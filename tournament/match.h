@@ -0,0 +1,41 @@
+#ifndef MATCH_H_
+#define MATCH_H_
+
+#include "../sim/sim.h"
+
+/**
+ * Everything needed to play one headless match.
+ */
+struct match_config
+{
+    unsigned int seed;
+    int width;
+    terrain_preset preset;
+    vector<brain_variant> players;
+    int max_rounds;
+    long max_ticks;
+};
+
+/**
+ * The outcome of a headless match. The winner is 0 if the match was drawn
+ * when the rounds ran out, or if the tick limit was hit before it ended.
+ */
+struct match_result
+{
+    int winner;
+    bool drawn;
+    long ticks;
+    double duration_ms;
+    vector<int> shots;
+};
+
+/**
+ * Play a full match between ai tanks, one per configured player, with no
+ * display or audio.
+ *
+ * @param    the match configuration
+ * @returns  the match result
+ */
+match_result play_match(const match_config &config);
+
+#endif
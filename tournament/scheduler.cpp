@@ -0,0 +1,96 @@
+#include "scheduler.h"
+
+#include <deque>  // work queues
+#include <mutex>  // queue locks
+#include <thread> // workers
+#include <vector>
+
+using namespace std;
+
+/**
+ * A worker's queue of job indices.
+ */
+struct work_queue
+{
+    deque<int> jobs;
+    mutex lock;
+};
+
+// forward declarations
+bool take_own_job(work_queue &q, int &job);
+bool steal_job(vector<work_queue> &queues, int thief, int &job);
+void work(vector<work_queue> &queues, int worker, const function<void(int, int)> &job);
+
+void run_work_stealing(int job_count, int worker_count, const function<void(int, int)> &job)
+{
+    if ( worker_count < 1 ) worker_count = 1;
+
+    vector<work_queue> queues(worker_count);
+
+    // deal jobs out round robin; stealing evens out whatever this gets wrong
+    for ( int i = 0; i < job_count; i++ )
+    {
+        queues[i % worker_count].jobs.push_back(i);
+    }
+
+    vector<thread> workers;
+    for ( int i = 1; i < worker_count; i++ )
+    {
+        workers.push_back(thread(work, ref(queues), i, cref(job)));
+    }
+    work(queues, 0, job);
+
+    for ( int i = 0; i < workers.size(); i++ )
+    {
+        workers[i].join();
+    }
+}
+
+/**
+ * a worker runs its own jobs, then steals until there is nothing left anywhere.
+ * No jobs are ever added once work starts, so an empty sweep means we're done.
+ */
+void work(vector<work_queue> &queues, int worker, const function<void(int, int)> &job)
+{
+    int next;
+
+    while ( take_own_job(queues[worker], next) or steal_job(queues, worker, next) )
+    {
+        job(next, worker);
+    }
+}
+
+/**
+ * pop from the back of our own queue
+ */
+bool take_own_job(work_queue &q, int &job)
+{
+    lock_guard<mutex> guard(q.lock);
+
+    if ( q.jobs.empty() ) return false;
+
+    job = q.jobs.back();
+    q.jobs.pop_back();
+    return true;
+}
+
+/**
+ * take from the front of the first other queue that has anything, starting
+ * with our neighbour so thieves spread out over different victims
+ */
+bool steal_job(vector<work_queue> &queues, int thief, int &job)
+{
+    for ( int i = 1; i < queues.size(); i++ )
+    {
+        work_queue &victim = queues[(thief + i) % queues.size()];
+        lock_guard<mutex> guard(victim.lock);
+
+        if ( not victim.jobs.empty() )
+        {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,18 @@
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <functional>
+
+/**
+ * Runs jobs 0..job_count-1 across a number of worker threads. Each worker
+ * owns a queue of jobs and takes from the back of it; a worker whose queue is
+ * empty steals from the front of another worker's queue, so long jobs on one
+ * thread don't leave the others idle. Returns once every job has finished.
+ *
+ * @param   the number of jobs
+ * @param   the number of worker threads
+ * @param   the job to run, given its index and the index of the worker
+ */
+void run_work_stealing(int job_count, int worker_count, const std::function<void(int, int)> &job);
+
+#endif
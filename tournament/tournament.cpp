@@ -0,0 +1,250 @@
+#include "match.h"
+#include "scheduler.h"
+#include "../sim/world.h"
+#include "../sim/tank.h"
+
+#include <algorithm> // max
+#include <chrono>   // wall time
+#include <cstdio>   // output
+#include <cstdlib>  // atoi
+#include <cstring>  // strcmp
+#include <thread>   // hardware_concurrency
+
+// constants
+#define DEFAULT_MATCHES 100
+#define DEFAULT_SEED 1
+#define DEFAULT_MAX_ROUNDS 50
+#define DEFAULT_MAX_TICKS 1000000
+
+/**
+ * Options read from the command line.
+ */
+struct tournament_options
+{
+    int matches;
+    unsigned int seed;
+    int width;
+    terrain_preset preset;
+    int threads;
+    int max_rounds;
+    long max_ticks;
+    const char *output;
+    vector<brain_variant> players;
+};
+
+// forward declarations
+bool parse_options(int argc, char *argv[], tournament_options &options);
+bool parse_variant(const char *name, brain_variant &variant);
+bool parse_preset(const char *name, terrain_preset &preset);
+bool parse_players(const char *arg, brain_variant &variant, int &count);
+const char *variant_name(brain_variant variant);
+void write_results(FILE *out, const tournament_options &options, const vector<match_result> &results);
+void write_summary(const tournament_options &options, const vector<match_result> &results, double wall_ms);
+void print_usage();
+
+/**
+ * Plays a batch of headless ai-vs-ai matches across every core and writes one
+ * csv line per match.
+ */
+int main(int argc, char *argv[])
+{
+    tournament_options options;
+
+    if ( not parse_options(argc, argv, options) )
+    {
+        print_usage();
+        return 1;
+    }
+
+    vector<match_result> results(options.matches);
+    auto started = chrono::steady_clock::now();
+
+    run_work_stealing(options.matches, options.threads, [&](int i, int worker)
+    {
+        match_config config;
+        config.seed = options.seed + i;
+        config.width = options.width;
+        config.preset = options.preset;
+        config.players = options.players;
+        config.max_rounds = options.max_rounds;
+        config.max_ticks = options.max_ticks;
+        results[i] = play_match(config);
+    });
+
+    chrono::duration<double, milli> wall = chrono::steady_clock::now() - started;
+
+    FILE *out = options.output ? fopen(options.output, "w") : stdout;
+    if ( not out )
+    {
+        fprintf(stderr, "could not open %s\n", options.output);
+        return 1;
+    }
+    write_results(out, options, results);
+    if ( out != stdout ) fclose(out);
+
+    write_summary(options, results, wall.count());
+
+    return 0;
+}
+
+/**
+ * read flags and player brain variants, returns false if anything is off
+ */
+bool parse_options(int argc, char *argv[], tournament_options &options)
+{
+    options.matches = DEFAULT_MATCHES;
+    options.seed = DEFAULT_SEED;
+    options.width = DEFAULT_WORLD_WIDTH;
+    options.preset = CLASSIC_TERRAIN;
+    options.threads = max(1u, thread::hardware_concurrency());
+    options.max_rounds = DEFAULT_MAX_ROUNDS;
+    options.max_ticks = DEFAULT_MAX_TICKS;
+    options.output = NULL;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        bool has_value = i + 1 < argc;
+        brain_variant variant;
+        int count;
+
+        if ( strcmp(argv[i], "-n") == 0 and has_value ) options.matches = atoi(argv[++i]);
+        else if ( strcmp(argv[i], "-s") == 0 and has_value ) options.seed = strtoul(argv[++i], NULL, 10);
+        else if ( strcmp(argv[i], "-w") == 0 and has_value ) options.width = atoi(argv[++i]);
+        else if ( strcmp(argv[i], "-p") == 0 and has_value )
+        {
+            if ( not parse_preset(argv[++i], options.preset) ) return false;
+        }
+        else if ( strcmp(argv[i], "-j") == 0 and has_value ) options.threads = atoi(argv[++i]);
+        else if ( strcmp(argv[i], "-r") == 0 and has_value ) options.max_rounds = atoi(argv[++i]);
+        else if ( strcmp(argv[i], "-t") == 0 and has_value ) options.max_ticks = atol(argv[++i]);
+        else if ( strcmp(argv[i], "-o") == 0 and has_value ) options.output = argv[++i];
+        else if ( parse_players(argv[i], variant, count) ) options.players.insert(options.players.end(), count, variant);
+        else return false;
+    }
+
+    // every tank needs room to spawn clear of the others, with plenty to spare
+    // so random placement finds it quickly
+    int min_width = 2 * options.players.size() * MIN_PLAYER_GAP + 2 * TANK_RADIUS + 20;
+
+    return options.players.size() >= 2 and options.players.size() <= MAX_PLAYERS and options.matches > 0 and
+           options.threads > 0 and options.max_rounds >= 0 and options.width >= min_width;
+}
+
+/**
+ * brain variants are named on the command line by their lowercase name
+ */
+bool parse_variant(const char *name, brain_variant &variant)
+{
+    if ( strcmp(name, "classic") == 0 ) variant = CLASSIC_BRAIN;
+    else if ( strcmp(name, "naive") == 0 ) variant = NAIVE_BRAIN;
+    else if ( strcmp(name, "search") == 0 ) variant = SEARCH_BRAIN;
+    else return false;
+
+    return true;
+}
+
+/**
+ * A player on the command line is a brain name, optionally followed by a colon
+ * and how many tanks get that brain, like search:16.
+ */
+bool parse_players(const char *arg, brain_variant &variant, int &count)
+{
+    string name = arg;
+    size_t colon = name.find(':');
+
+    count = 1;
+    if ( colon != string::npos )
+    {
+        count = atoi(name.c_str() + colon + 1);
+        name = name.substr(0, colon);
+    }
+
+    return count > 0 and parse_variant(name.c_str(), variant);
+}
+
+/**
+ * terrain presets are named on the command line by a short lowercase name
+ */
+bool parse_preset(const char *name, terrain_preset &preset)
+{
+    if ( strcmp(name, "classic") == 0 ) preset = CLASSIC_TERRAIN;
+    else if ( strcmp(name, "hills") == 0 ) preset = ROLLING_HILLS;
+    else if ( strcmp(name, "plateaus") == 0 ) preset = PLATEAUS;
+    else if ( strcmp(name, "mountains") == 0 ) preset = MOUNTAINS;
+    else return false;
+
+    return true;
+}
+
+const char *variant_name(brain_variant variant)
+{
+    switch ( variant )
+    {
+        case CLASSIC_BRAIN: return "classic";
+        case NAIVE_BRAIN: return "naive";
+        case SEARCH_BRAIN: return "search";
+    }
+    return "unknown";
+}
+
+/**
+ * one csv line per match, in match order whatever order they finished in
+ */
+void write_results(FILE *out, const tournament_options &options, const vector<match_result> &results)
+{
+    fprintf(out, "match,seed,winner,winner_brain,ticks,duration_ms");
+    for ( int p = 0; p < options.players.size(); p++ )
+    {
+        fprintf(out, ",shots_%d", p + 1);
+    }
+    fprintf(out, "\n");
+
+    for ( int i = 0; i < results.size(); i++ )
+    {
+        const match_result &r = results[i];
+        const char *winner_brain = r.winner ? variant_name(options.players[r.winner - 1])
+                                            : ( r.drawn ? "draw" : "none" );
+
+        fprintf(out, "%d,%u,%d,%s,%ld,%.3f", i, options.seed + i, r.winner, winner_brain,
+                r.ticks, r.duration_ms);
+        for ( int p = 0; p < r.shots.size(); p++ )
+        {
+            fprintf(out, ",%d", r.shots[p]);
+        }
+        fprintf(out, "\n");
+    }
+}
+
+/**
+ * wins per player and overall throughput, to stderr so the csv stays clean
+ */
+void write_summary(const tournament_options &options, const vector<match_result> &results, double wall_ms)
+{
+    vector<int> wins(options.players.size() + 1, 0);
+    int drawn = 0;
+    long ticks = 0;
+
+    for ( int i = 0; i < results.size(); i++ )
+    {
+        wins[results[i].winner]++;
+        drawn += results[i].drawn;
+        ticks += results[i].ticks;
+    }
+
+    for ( int p = 0; p < options.players.size(); p++ )
+    {
+        fprintf(stderr, "player %d (%s): %d wins\n", p + 1, variant_name(options.players[p]), wins[p + 1]);
+    }
+    fprintf(stderr, "drawn: %d\n", drawn);
+    fprintf(stderr, "unfinished: %d\n", wins[0] - drawn);
+    fprintf(stderr, "%d matches on %d threads in %.0f ms (%.0f ticks/s)\n", options.matches,
+            options.threads, wall_ms, ticks / (wall_ms / 1000.0));
+}
+
+void print_usage()
+{
+    fprintf(stderr, "usage: tournament [-n matches] [-s seed] [-w world width] [-p terrain] [-j threads]\n"
+                    "                  [-r max rounds] [-t max ticks] [-o csv] brain[:count] brain[:count] ...\n"
+                    "brains: classic, naive, search\n"
+                    "terrain: classic, hills, plateaus, mountains\n");
+}
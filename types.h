@@ -1,9 +1,6 @@
 #ifndef TYPES_H_
 #define TYPES_H_ 
 
-// forward declarations
-struct tank;
-
 /**
  * The current state the game is in.
  */
@@ -16,126 +13,155 @@ enum game_state
 };
 
 /**
- * The current state a brain is in.
+ * An element of the ui that knows where it is and what it looks like.
  */
-enum brain_state
+struct ui_element
 {
-    THINKING,
-    READY,
-    WAITING
+    point_2d coords;
+    bitmap bmp;
+    color clr;
 };
 
 /**
- * Terrain represents the landscape on which the tank battle takes place
+ * A toggle used to swap between a human and AI player.
  */
-struct terrain
+struct player_toggle
 {
-    bitmap bmp;
-    int tops[WINDOW_WIDTH];
+    ui_element human;
+    ui_element robot;
 };
 
 /**
- * Shot is a shot fired from a tank.
+ * The set of ui elements in the menu ui, and the stream ai tanks are named
+ * from, kept apart from the world's so naming one does not move the spawns.
  */
-struct shot
+struct menu_screen
 {
-    double initial_y;
-    double initial_x;
-    color clr;
-    int initial_angle;
-    double power;
-    double distance;
-    point_2d coords;
+    ui_element less_tanks;
+    ui_element more_tanks;
+    ui_element play;
+    vector<ui_element> name_boxes;
+    vector<player_toggle> player_toggles;
+    bool editing_name;
+    tank *editing_tank;
+    ui_element *editing_box;
+    random_stream names;
 };
 
 /**
- * Brain, makes smart.
+ * The set of ui elements in the won ui.
  */
-struct brain
+struct won_screen
 {
-    brain_state state;
-    tank *target;
-    shot *last_shot;
-    int target_angle;
-    int target_power;
+    ui_element restart;
 };
 
 /**
- * Tanks. Enough said.
+ * An explosion being shown on screen. It grows ring by ring as it ages.
  */
-struct tank
+struct explosion_animation
 {
-    int id;
-    string name;
-    bool is_ai;
-    brain ai;
-    color clr;
-    int health;
-    bool alive;
-    bitmap bmp;
-    point_2d coords;
-    int turret_angle;
-    point_2d turret_end;
-    int power;
-    int base_angle;
-    bool shooting;
-    shot active_shot;
+    world_point coords;
+    int radius;
+    double age_ms;
 };
 
 /**
- * An element of the ui that knows where it is and what it looks like.
+ * What a particle is. Each kind has its own look, and feels gravity and the
+ * wind by its own amounts.
  */
-struct ui_element
+enum particle_kind
 {
-    point_2d coords;
-    bitmap bmp;
-    color clr;
+    DIRT_PARTICLE,
+    DEBRIS_PARTICLE,
+    SMOKE_PARTICLE
 };
 
 /**
- * A toggle used to swap between a human and AI player.
+ * Dirt, debris and smoke thrown up by explosions and wrecked tanks. Each
+ * attribute is its own array, made MAX_PARTICLES long up front so nothing
+ * is allocated while playing, and the first count are live; particles
+ * spawned while it is full are dropped. Weight is how much of gravity a
+ * particle feels, negative for smoke that rises, and drift is how quickly it
+ * takes up the speed of the wind. Ages and lives are in seconds.
  */
-struct player_toggle
+struct particle_system
 {
-    ui_element human;
-    ui_element robot;
+    int count;
+    vector<double> x;
+    vector<double> y;
+    vector<double> speed_x;
+    vector<double> speed_y;
+    vector<double> weight;
+    vector<double> drift;
+    vector<double> age;
+    vector<double> life;
+    vector<particle_kind> kind;
+    vector<color> clr;
+    random_stream random;
 };
 
 /**
- * The set of ui elements in the menu ui.
+ * Where moving things were before the latest world tick, so drawing can blend
+ * between the last two ticks.
  */
-struct menu_screen
+struct world_snapshot
 {
-    ui_element less_tanks;
-    ui_element more_tanks;
-    ui_element play;
-    vector<ui_element> name_boxes;
-    vector<player_toggle> player_toggles;
-    bool editing_name;
-    tank *editing_tank;
-    ui_element *editing_box;
+    vector<world_point> tank_coords;
 };
 
 /**
- * The set of ui elements in the won ui.
+ * The camera follows the action across a world wider than the window. X is the
+ * world column at the left edge of the window.
  */
-struct won_screen
+struct camera
 {
-    ui_element restart;
+    double x;
+};
+
+/**
+ * One square tile of the terrain image. Its bitmap is only made once the tile
+ * is on screen with ground in it, and is NULL until then. A dirty tile is
+ * drawn again before it is next shown.
+ */
+struct terrain_tile
+{
+    bitmap bmp;
+    bool dirty;
+};
+
+/**
+ * The terrain image, cut into a grid of tiles columns wide and rows high,
+ * stored a column of tiles at a time. Made lists the tiles that have a bitmap
+ * right now, so tiles that scroll out of view can be let go without looking
+ * at the rest.
+ */
+struct terrain_tiles
+{
+    int columns;
+    int rows;
+    vector<terrain_tile> tiles;
+    vector<int> made;
 };
 
 /**
- * The game object manages all relevant state for the game.
+ * The game object is the GUI front end over a simulated world: it owns the
+ * world along with everything needed to show it.
  */
 struct game
 {
-    terrain game_terrain;
-    vector<tank> tanks;
-    tank *active_tank;
+    world game_world;
+    terrain_tiles terrain_image;
+    camera view;
+    world_snapshot previous;
+    vector<explosion_animation> explosions;
+    particle_system particles;
+    double last_frame_ms;
+    double tick_accumulator_ms;
+    double interpolation;
     game_state state;
     menu_screen menu_ui;
     won_screen won_ui;
-    double wind_strength;
 };
 
 #endif
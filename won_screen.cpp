@@ -1,5 +1,6 @@
 #include "won_screen.h"
 #include "game.h"
+#include "render.h"
 
 // constants
 #define WINNER_COPY "WINNER: "
@@ -44,31 +45,8 @@ ui_element new_restart_button()
     return restart_button;
 }
 
-bool game_won(const game &g)
-{
-    int alive = 0;
-
-    for ( int i = 0; i < g.tanks.size(); i++ )
-    {
-        if ( g.tanks[i].alive )
-        {
-            alive++;
-        }
-    }
-
-    return alive == 1;
-}
-
 void win_game(game &g)
 {
-    for ( int i = 0; i < g.tanks.size(); i++ )
-    {
-        if ( g.tanks[i].alive )
-        {
-            g.active_tank = &(g.tanks[i]);
-        }
-    }
-
     play_sound_effect("win");
     g.state = WON;
 }
@@ -80,7 +58,7 @@ void handle_won_screen_input(game &g)
 
 void draw_won_screen(const game &g)
 {
-    draw_text(WINNER_COPY + g.active_tank->name, g.active_tank->clr, TEXT_FONT,
+    draw_text(WINNER_COPY + g.game_world.active_tank->name, tank_color(*(g.game_world.active_tank)), TEXT_FONT,
               BIG_FONT_SIZE, WINNER_TEXT_X, WINNER_TEXT_Y);
     draw_ui_element(g.won_ui.restart);
 }
@@ -94,6 +72,7 @@ void handle_restart(game &g)
     {
         stop_music();
         play_sound_effect("click");
+        free_terrain_tiles(g.terrain_image);
         g = new_game();
     }
 }
@@ -11,14 +11,6 @@
  */
 won_screen new_won_screen(const game &g);
 
-/**
- * Has the game been won? This will be true if the active tank is teh only tank
- * remaining alive.
- *
- * @param   the game that might have been won
- */
-bool game_won(const game &g);
-
 /**
  * Make change to game state to reflect that it has been won.
  *